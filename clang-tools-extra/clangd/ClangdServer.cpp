@@ -70,10 +70,12 @@ struct UpdateIndexCallbacks : public ParsingCallbacks {
   UpdateIndexCallbacks(FileIndex *FIndex,
                        ClangdServer::Callbacks *ServerCallbacks,
                        const ThreadsafeFS &TFS, AsyncTaskRunner *Tasks,
-                       bool CollectInactiveRegions)
+                       bool CollectInactiveRegions,
+                       std::function<void(PathRef, bool)> OnForegroundActivity)
       : FIndex(FIndex), ServerCallbacks(ServerCallbacks), TFS(TFS),
         Stdlib{std::make_shared<StdLibSet>()}, Tasks(Tasks),
-        CollectInactiveRegions(CollectInactiveRegions) {}
+        CollectInactiveRegions(CollectInactiveRegions),
+        OnForegroundActivity(std::move(OnForegroundActivity)) {}
 
   void onPreambleAST(
       PathRef Path, llvm::StringRef Version, CapturedASTCtx ASTCtx,
@@ -157,6 +159,10 @@ struct UpdateIndexCallbacks : public ParsingCallbacks {
   void onFileUpdated(PathRef File, const TUStatus &Status) override {
     if (ServerCallbacks)
       ServerCallbacks->onFileUpdated(File, Status);
+    if (OnForegroundActivity)
+      OnForegroundActivity(File,
+                           Status.PreambleActivity != PreambleAction::Idle ||
+                               Status.ASTActivity.K != ASTAction::Idle);
   }
 
   void onPreamblePublished(PathRef File) override {
@@ -171,6 +177,7 @@ private:
   std::shared_ptr<StdLibSet> Stdlib;
   AsyncTaskRunner *Tasks;
   bool CollectInactiveRegions;
+  std::function<void(PathRef, bool)> OnForegroundActivity;
 };
 
 class DraftStoreFS : public ThreadsafeFS {
@@ -238,7 +245,10 @@ ClangdServer::ClangdServer(const GlobalCompilationDatabase &CDB,
                         std::make_unique<UpdateIndexCallbacks>(
                             DynamicIdx.get(), Callbacks, TFS,
                             IndexTasks ? &*IndexTasks : nullptr,
-                            PublishInactiveRegions));
+                            PublishInactiveRegions,
+                            [this](PathRef File, bool Busy) {
+                              noteForegroundActivity(File, Busy);
+                            }));
   // Adds an index to the stack, at higher priority than existing indexes.
   auto AddIndex = [&](SymbolIndex *Idx) {
     if (this->Index != nullptr) {
@@ -416,6 +426,21 @@ ClangdServer::createConfiguredContextProvider(const config::Provider *Provider,
 void ClangdServer::removeDocument(PathRef File) {
   DraftMgr.removeDraft(File);
   WorkScheduler->remove(File);
+  // The worker for File has stopped publishing its status, so it won't report
+  // going idle by itself.
+  noteForegroundActivity(File, false);
+}
+
+void ClangdServer::noteForegroundActivity(PathRef File, bool Busy) {
+  std::lock_guard<std::mutex> Lock(BusyFilesMu);
+  bool WasBusy = !BusyFiles.empty();
+  if (Busy)
+    BusyFiles.insert(File);
+  else
+    BusyFiles.erase(File);
+  // Notify under the lock so that concurrent transitions are applied in order.
+  if (BackgroundIdx && WasBusy != !BusyFiles.empty())
+    BackgroundIdx->setForegroundBusy(!BusyFiles.empty());
 }
 
 void ClangdServer::codeComplete(PathRef File, Position Pos,
@@ -34,8 +34,10 @@
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/FunctionExtras.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/StringSet.h"
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <tuple>
@@ -488,6 +490,11 @@ private:
   std::unique_ptr<FileIndex> DynamicIdx;
   // If present, the new "auto-index" maintained in background threads.
   std::unique_ptr<BackgroundIndex> BackgroundIdx;
+  // Open files with queued or running foreground work. BackgroundIdx is
+  // throttled while this is non-empty.
+  llvm::StringSet<> BusyFiles; // GUARDED_BY(BusyFilesMu)
+  std::mutex BusyFilesMu;
+  void noteForegroundActivity(PathRef File, bool Busy);
   // Storage for merged views of the various indexes.
   std::vector<std::unique_ptr<SymbolIndex>> MergedIdx;
   // Manage module files.
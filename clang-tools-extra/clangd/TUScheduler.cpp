@@ -1086,6 +1086,10 @@ void PreambleThread::build(Request Req) {
 
   PreambleBuildStats Stats;
   bool IsFirstPreamble = !LatestBuild;
+  // FIXME: Files with the same include prefix and flags each build their own
+  // preamble. Sharing one is not just a cache lookup: the PCH is built for
+  // this main file's path, and PreambleData records diagnostics, includes and
+  // macro locations against this file.
   LatestBuild = clang::clangd::buildPreamble(
       FileName, *Req.CI, Inputs, StoreInMemory,
       [&](CapturedASTCtx ASTCtx,
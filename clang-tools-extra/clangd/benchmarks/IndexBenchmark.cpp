@@ -8,6 +8,8 @@
 
 #include "../index/Serialization.h"
 #include "../index/dex/Dex.h"
+#include "../index/dex/Iterator.h"
+#include "../index/dex/PostingList.h"
 #include "benchmark/benchmark.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
@@ -97,6 +99,24 @@ static void dexBuild(benchmark::State &State) {
 }
 BENCHMARK(dexBuild);
 
+// Intersects two synthetic posting lists of State.range(0) documents each,
+// one dense and one sparse, independent of the index passed on the command
+// line.
+static void dexPostingListIntersection(benchmark::State &State) {
+  std::vector<dex::DocID> Dense, Sparse;
+  for (int64_t I = 0; I < State.range(0); ++I) {
+    Dense.push_back(I * 2);
+    Sparse.push_back(I * 37);
+  }
+  const dex::PostingList DenseList(Dense), SparseList(Sparse);
+  const dex::Corpus Corpus(State.range(0) * 37);
+  for (auto _ : State) {
+    auto And = Corpus.intersect(DenseList.iterator(), SparseList.iterator());
+    benchmark::DoNotOptimize(dex::consume(*And));
+  }
+}
+BENCHMARK(dexPostingListIntersection)->Range(1 << 10, 1 << 20);
+
 } // namespace
 } // namespace clangd
 } // namespace clang
@@ -100,6 +100,9 @@ public:
   // lower priority.
   // Reducing the boost of a tag affects future tasks but not current ones.
   void boost(llvm::StringRef Tag, unsigned NewPriority);
+  // Run at most Limit tasks at once; 0 means no limit. Tasks that are already
+  // running are not interrupted, other workers wait until they fit.
+  void setConcurrencyLimit(unsigned Limit);
 
   // Process items on the queue until the queue is stopped.
   // If the queue becomes empty, OnIdle will be called (on one worker).
@@ -122,6 +125,7 @@ private:
   Stats Stat;
   std::condition_variable CV;
   bool ShouldStop = false;
+  unsigned ConcurrencyLimit = 0;
   std::vector<Task> Queue; // max-heap
   llvm::StringMap<unsigned> Boosts;
   std::function<void(Stats)> OnProgress;
@@ -148,6 +152,10 @@ public:
     // Whether the index needs to support the containedRefs() operation.
     // May use extra memory.
     bool SupportContainedRefs = true;
+    // Number of indexing tasks allowed to run while there is foreground work
+    // (e.g. building ASTs of open files) pending, see setForegroundBusy().
+    // 0 means background indexing is never throttled.
+    unsigned ThreadsWhileForegroundBusy = 1;
   };
 
   /// Creates a new background index and starts its threads.
@@ -168,6 +176,11 @@ public:
   /// Typically used to index TUs when headers are opened.
   void boostRelated(llvm::StringRef Path);
 
+  // Throttles indexing while Busy, so foreground work gets most of the cores.
+  void setForegroundBusy(bool Busy) {
+    Queue.setConcurrencyLimit(Busy ? ThreadsWhileForegroundBusy : 0);
+  }
+
   // Cause background threads to stop after ther current task, any remaining
   // tasks will be discarded.
   void stop() {
@@ -202,6 +215,7 @@ private:
   const GlobalCompilationDatabase &CDB;
   llvm::ThreadPriority IndexingPriority;
   std::function<Context(PathRef)> ContextProvider;
+  unsigned ThreadsWhileForegroundBusy;
 
   llvm::Error index(tooling::CompileCommand);
 
@@ -24,7 +24,11 @@ void BackgroundQueue::work(std::function<void()> OnIdle) {
     std::optional<Task> Task;
     {
       std::unique_lock<std::mutex> Lock(Mu);
-      CV.wait(Lock, [&] { return ShouldStop || !Queue.empty(); });
+      CV.wait(Lock, [&] {
+        return ShouldStop ||
+               (!Queue.empty() &&
+                (ConcurrencyLimit == 0 || Stat.Active < ConcurrencyLimit));
+      });
       if (ShouldStop) {
         Queue.clear();
         CV.notify_all();
@@ -133,6 +137,15 @@ void BackgroundQueue::boost(llvm::StringRef Tag, unsigned NewPriority) {
   // No need to signal, only rearranged items in the queue.
 }
 
+void BackgroundQueue::setConcurrencyLimit(unsigned Limit) {
+  {
+    std::lock_guard<std::mutex> Lock(Mu);
+    ConcurrencyLimit = Limit;
+  }
+  // Raising the limit may let waiting workers proceed.
+  CV.notify_all();
+}
+
 bool BackgroundQueue::blockUntilIdleForTest(
     std::optional<double> TimeoutSeconds) {
   std::unique_lock<std::mutex> Lock(Mu);
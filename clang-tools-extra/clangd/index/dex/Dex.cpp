@@ -60,6 +60,11 @@ class IndexBuilder {
   llvm::StringMap<std::vector<DocID>> TypeDocs;
   llvm::StringMap<std::vector<DocID>> ScopeDocs;
   llvm::StringMap<std::vector<DocID>> ProximityDocs;
+  // Many symbols share a file, so remember which ProximityDocs entries each
+  // file URI expands to instead of regenerating and hashing them every time.
+  // StringMap values don't move on rehash, so the pointers stay valid.
+  llvm::DenseMap<const char *, std::vector<std::vector<DocID> *>>
+      FileProximityDocs;
   std::vector<Trigram> TrigramScratch;
 
 public:
@@ -72,10 +77,16 @@ public:
     for (Trigram T : TrigramScratch)
       TrigramDocs[T].push_back(D);
     ScopeDocs[Sym.Scope].push_back(D);
-    if (!llvm::StringRef(Sym.CanonicalDeclaration.FileURI).empty())
-      for (const auto &ProximityURI :
-           generateProximityURIs(Sym.CanonicalDeclaration.FileURI))
-        ProximityDocs[ProximityURI].push_back(D);
+    if (!llvm::StringRef(Sym.CanonicalDeclaration.FileURI).empty()) {
+      auto [It, Inserted] =
+          FileProximityDocs.try_emplace(Sym.CanonicalDeclaration.FileURI);
+      if (Inserted)
+        for (const auto &ProximityURI :
+             generateProximityURIs(Sym.CanonicalDeclaration.FileURI))
+          It->second.push_back(&ProximityDocs[ProximityURI]);
+      for (std::vector<DocID> *Docs : It->second)
+        Docs->push_back(D);
+    }
     if (Sym.Flags & Symbol::IndexedForCodeCompletion)
       RestrictedCCDocs.push_back(D);
     if (!Sym.Type.empty())
@@ -84,6 +95,7 @@ public:
 
   // Assemble the final compressed posting lists for the added symbols.
   llvm::DenseMap<Token, PostingList> build() && {
+    FileProximityDocs = {};
     llvm::DenseMap<Token, PostingList> Result(/*InitialReserve=*/
                                               TrigramDocs.size() +
                                               RestrictedCCDocs.size() +
@@ -124,6 +136,7 @@ public:
 void Dex::buildIndex(bool SupportContainedRefs) {
   this->Corpus = dex::Corpus(Symbols.size());
   std::vector<std::pair<float, const Symbol *>> ScoredSymbols(Symbols.size());
+  LookupTable.reserve(Symbols.size());
 
   for (size_t I = 0; I < Symbols.size(); ++I) {
     const Symbol *Sym = Symbols[I];
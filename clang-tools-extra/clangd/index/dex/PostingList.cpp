@@ -10,7 +10,7 @@
 #include "index/dex/Iterator.h"
 #include "index/dex/Token.h"
 #include "llvm/Support/MathExtras.h"
-#include <optional>
+#include <algorithm>
 
 namespace clang {
 namespace clangd {
@@ -101,9 +101,16 @@ private:
   void advanceToChunk(DocID ID) {
     if ((CurrentChunk != Chunks.end() - 1) &&
         ((CurrentChunk + 1)->Head <= ID)) {
-      CurrentChunk =
-          std::partition_point(CurrentChunk + 1, Chunks.end(),
-                               [&](const Chunk &C) { return C.Head < ID; });
+      // Intersections mostly ask for nearby IDs, so gallop ahead to bracket
+      // the target chunk before binary searching within the bracket.
+      auto Begin = CurrentChunk + 1;
+      size_t Remaining = Chunks.end() - Begin;
+      size_t Bound = 1;
+      while (Bound < Remaining && Begin[Bound].Head < ID)
+        Bound *= 2;
+      CurrentChunk = std::partition_point(
+          Begin + Bound / 2, Begin + std::min(Bound, Remaining),
+          [&](const Chunk &C) { return C.Head < ID; });
       --CurrentChunk;
       DecompressedChunk = CurrentChunk->decompress();
       CurrentID = DecompressedChunk.begin();
@@ -181,38 +188,29 @@ std::vector<Chunk> encodeStream(llvm::ArrayRef<DocID> Documents) {
   return std::vector<Chunk>(Result); // no move, shrink-to-fit
 }
 
-/// Reads variable length DocID from the buffer and updates the buffer size. If
-/// the stream is terminated, return std::nullopt.
-std::optional<DocID> readVByte(llvm::ArrayRef<uint8_t> &Bytes) {
-  if (Bytes.front() == 0 || Bytes.empty())
-    return std::nullopt;
-  DocID Result = 0;
-  bool HasNextByte = true;
-  for (size_t Length = 0; HasNextByte && !Bytes.empty(); ++Length) {
-    assert(Length <= 5 && "Malformed VByte encoding sequence.");
-    // Write meaningful bits to the correct place in the document decoding.
-    Result |= (Bytes.front() & 0x7f) << (BitsPerEncodingByte * Length);
-    if ((Bytes.front() & 0x80) == 0)
-      HasNextByte = false;
-    Bytes = Bytes.drop_front();
-  }
-  return Result;
-}
-
 } // namespace
 
 llvm::SmallVector<DocID, Chunk::PayloadSize + 1> Chunk::decompress() const {
   llvm::SmallVector<DocID, Chunk::PayloadSize + 1> Result{Head};
-  llvm::ArrayRef<uint8_t> Bytes(Payload);
-  DocID Delta;
-  for (DocID Current = Head; !Bytes.empty(); Current += Delta) {
-    auto MaybeDelta = readVByte(Bytes);
-    if (!MaybeDelta)
-      break;
-    Delta = *MaybeDelta;
-    Result.push_back(Current + Delta);
+  // Decode the VByte deltas written by encodeVByte(). The payload is
+  // terminated by a zero byte or by its end, whichever comes first.
+  const uint8_t *Bytes = Payload.begin(), *End = Payload.end();
+  DocID Current = Head;
+  while (Bytes != End && *Bytes != 0) {
+    DocID Delta = 0;
+    unsigned Shift = 0;
+    uint8_t Byte;
+    do {
+      assert(Shift <= BitsPerEncodingByte * 4 &&
+             "Malformed VByte encoding sequence.");
+      Byte = *Bytes++;
+      Delta |= DocID(Byte & 0x7f) << Shift;
+      Shift += BitsPerEncodingByte;
+    } while ((Byte & 0x80) && Bytes != End);
+    Current += Delta;
+    Result.push_back(Current);
   }
-  return llvm::SmallVector<DocID, Chunk::PayloadSize + 1>{Result};
+  return Result;
 }
 
 PostingList::PostingList(llvm::ArrayRef<DocID> Documents)
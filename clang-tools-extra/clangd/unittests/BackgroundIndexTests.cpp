@@ -850,6 +850,29 @@ TEST(BackgroundQueueTest, Duplicates) {
   EXPECT_EQ("ABB BB", Sequence);
 }
 
+TEST(BackgroundQueueTest, ConcurrencyLimit) {
+  BackgroundQueue Q;
+  Q.setConcurrencyLimit(1);
+  std::atomic<unsigned> Running(0), MaxRunning(0), Ran(0);
+  BackgroundQueue::Task T([&] {
+    unsigned Now = ++Running;
+    unsigned Max = MaxRunning;
+    while (Max < Now && !MaxRunning.compare_exchange_weak(Max, Now))
+      ;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    --Running;
+    ++Ran;
+  });
+  Q.append(std::vector<BackgroundQueue::Task>(20, T));
+
+  AsyncTaskRunner ThreadPool;
+  for (unsigned I = 0; I < 4; ++I)
+    ThreadPool.runAsync("worker", [&] { Q.work([&] { Q.stop(); }); });
+  ThreadPool.wait();
+  EXPECT_EQ(Ran, 20u);
+  EXPECT_EQ(MaxRunning, 1u);
+}
+
 TEST(BackgroundQueueTest, Progress) {
   using testing::AnyOf;
   BackgroundQueue::Stats S;
@@ -65,6 +65,24 @@ TEST(DexIterators, DocumentIterator) {
   EXPECT_TRUE(DocIterator->reachedEnd());
 }
 
+TEST(DexIterators, AdvanceToAcrossChunks) {
+  // Enough documents to span many chunks, with gaps of varying width.
+  std::vector<DocID> Docs;
+  for (DocID D = 0; D < 100000; D += 1 + D % 300)
+    Docs.push_back(D);
+  const PostingList L(Docs);
+  auto DocIterator = L.iterator();
+
+  for (DocID Target : {0U, 1U, 301U, 5000U, 5001U, 70000U, 70001U, 99000U}) {
+    DocIterator->advanceTo(Target);
+    ASSERT_FALSE(DocIterator->reachedEnd());
+    EXPECT_EQ(DocIterator->peek(), *llvm::lower_bound(Docs, Target));
+  }
+  DocIterator->advanceTo(Docs.back() + 1);
+  EXPECT_TRUE(DocIterator->reachedEnd());
+  EXPECT_THAT(consumeIDs(*L.iterator()), ::testing::ElementsAreArray(Docs));
+}
+
 TEST(DexIterators, AndTwoLists) {
   Corpus C{10000};
   const PostingList L0({0, 5, 7, 10, 42, 320, 9000});
@@ -301,6 +301,10 @@ public:
   /// AST file.
   const uint32_t *SLocEntryOffsets = nullptr;
 
+  /// The local index of the entry found by the most recent offset lookup into
+  /// this AST file. Lookups cluster, so this is tried before searching.
+  unsigned LastSLocEntryLookup = 0;
+
   // === Identifiers ===
 
   /// The number of identifiers in this AST file.
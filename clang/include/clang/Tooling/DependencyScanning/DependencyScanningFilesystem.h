@@ -12,8 +12,10 @@
 #include "clang/Basic/LLVM.h"
 #include "clang/Lex/DependencyDirectivesScanner.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/STLFunctionalExtras.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/Support/Allocator.h"
+#include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorOr.h"
 #include "llvm/Support/VirtualFileSystem.h"
 #include <mutex>
@@ -250,9 +252,57 @@ public:
   std::vector<OutOfDateEntry>
   getOutOfDateEntries(llvm::vfs::FileSystem &UnderlyingFS) const;
 
+  /// Re-stats all cached entries using UnderlyingFS and returns true if any of
+  /// them no longer describes the file on the UnderlyingFS: a file that was
+  /// cached as missing now exists, a cached file or directory was removed or
+  /// replaced, or a cached file's size or modification time changed.
+  ///
+  /// Unlike \c getOutOfDateEntries(), the shard locks are only held while
+  /// collecting the entries, not while stat-ing them.
+  bool hasChangedEntries(llvm::vfs::FileSystem &UnderlyingFS) const;
+
+  /// Loads the directive scan results that a previous invocation stored with
+  /// \c writePersistentDirectives(). A missing, stale or malformed file is
+  /// not an error: the persistent cache then simply starts out empty.
+  ///
+  /// Must be called before any worker filesystem starts using this cache.
+  void readPersistentDirectives(StringRef Path);
+
+  /// Stores the directive scan results of all files in this cache to \p Path,
+  /// so that later invocations can skip scanning files that did not change.
+  llvm::Error writePersistentDirectives(StringRef Path) const;
+
+  /// Fills \p Tokens and \p Directives with the persisted scan result of the
+  /// file described by \p Stat with contents \p Contents. Results are only
+  /// reused if the unique ID, modification time, size and content hash of the
+  /// file all match.
+  ///
+  /// \returns true if a persisted result was found.
+  bool getPersistentDirectives(
+      const llvm::vfs::Status &Stat, StringRef Contents,
+      SmallVectorImpl<dependency_directives_scan::Token> &Tokens,
+      SmallVectorImpl<dependency_directives_scan::Directive> &Directives) const;
+
 private:
   std::unique_ptr<CacheShard[]> CacheShards;
   unsigned NumShards;
+
+  /// A scan result loaded from the persistent cache file. \c Data points into
+  /// \c PersistentBuffer and is only decoded when the file is used.
+  struct PersistentEntry {
+    uint64_t ModificationTime;
+    uint64_t Size;
+    uint64_t ContentHash;
+    uint32_t NumTokens;
+    uint32_t NumDirectives;
+    const char *Data;
+  };
+
+  /// The mapped persistent cache file, if any.
+  std::unique_ptr<llvm::MemoryBuffer> PersistentBuffer;
+
+  /// Persisted scan results, keyed by the unique ID of the file.
+  llvm::DenseMap<llvm::sys::fs::UniqueID, PersistentEntry> PersistentEntries;
 };
 
 /// This class is a local cache, that caches the 'stat' and 'open' calls to the
@@ -288,6 +338,15 @@ public:
     return *CachedEntry;
   }
 
+  /// Calls \p Callback with every filename that has an entry in this cache.
+  void forEachEntry(
+      llvm::function_ref<void(StringRef, const CachedFileSystemEntry &)>
+          Callback) const {
+    for (const auto &[Filename, CachedPair] : Cache)
+      if (CachedPair.first)
+        Callback(Filename, *CachedPair.first);
+  }
+
   /// Returns real path associated with the filename or nullptr if none is
   /// found.
   const CachedRealPath *findRealPathByFilename(StringRef Filename) const {
@@ -401,6 +460,13 @@ public:
   /// false if not (i.e. this entry is not a file or its scan fails).
   bool ensureDirectiveTokensArePopulated(EntryRef Entry);
 
+  /// Re-stats the entries that were looked up through this filesystem using
+  /// \p UnderlyingFS and returns true if any of them changed, like
+  /// \c DependencyScanningFilesystemSharedCache::hasChangedEntries() does for
+  /// the whole shared cache. Scans that ran on this filesystem only depend on
+  /// these entries.
+  bool hasChangedEntries(llvm::vfs::FileSystem &UnderlyingFS) const;
+
   /// \returns The scanned preprocessor directive tokens of the file that are
   /// used to speed up preprocessing, if available.
   std::optional<ArrayRef<dependency_directives_scan::Directive>>
@@ -1049,18 +1049,29 @@ private:
     const bool EnableCheckProfiling = Options.CheckProfiling.has_value();
     TimeBucketRegion Timer;
     auto &Matchers = this->Matchers->DeclOrStmt;
+    // Whether the node is skipped by traverseIgnored() depends only on the
+    // traversal kind, and most matchers share one, so reuse the answer for
+    // consecutive matchers with the same kind.
+    bool HaveLastTK = false;
+    std::optional<TraversalKind> LastTK;
+    bool LastTKIgnoresNode = false;
     for (unsigned short I : Filter) {
       auto &MP = Matchers[I];
       if (EnableCheckProfiling)
         Timer.setBucket(&TimeByBucket[MP.second->getID()]);
       BoundNodesTreeBuilder Builder;
 
-      {
-        TraversalKindScope RAII(getASTContext(), MP.first.getTraversalKind());
-        if (getASTContext().getParentMapContext().traverseIgnored(DynNode) !=
-            DynNode)
-          continue;
+      std::optional<TraversalKind> TK = MP.first.getTraversalKind();
+      if (!HaveLastTK || TK != LastTK) {
+        TraversalKindScope RAII(getASTContext(), TK);
+        LastTKIgnoresNode =
+            getASTContext().getParentMapContext().traverseIgnored(DynNode) !=
+            DynNode;
+        LastTK = TK;
+        HaveLastTK = true;
       }
+      if (LastTKIgnoresNode)
+        continue;
 
       CurMatchRAII RAII(*this, MP.second, DynNode);
       if (MP.first.matches(DynNode, this, &Builder)) {
@@ -500,7 +500,7 @@ llvm::Error CrossTranslationUnitContext::ASTUnitStorage::ensureCTUIndexLoaded(
 
   if (auto IndexMapping = parseCrossTUIndex(IndexFile)) {
     // Initialize member map.
-    NameFileMap = *IndexMapping;
+    NameFileMap = std::move(*IndexMapping);
     return llvm::Error::success();
   } else {
     // Error while parsing CrossTU index file.
@@ -26,6 +26,12 @@
 #include "llvm/ADT/StringSwitch.h"
 #include <optional>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 using namespace clang;
 using namespace clang::dependency_directives_scan;
 using namespace llvm;
@@ -418,6 +424,56 @@ static bool isQuoteCppDigitSeparator(const char *const Start,
   return (Cur + 1) < End && isAsciiIdentifierContinue(*(Cur + 1));
 }
 
+/// Returns the first character at or after \p First that \c skipLine needs to
+/// look at individually: a quote, a backslash, a slash or a newline. Only
+/// whole 16-byte chunks are classified, so the result may stop short of that
+/// character and the caller is expected to finish the job byte by byte.
+static const char *findNextSkipLineSpecialChar(const char *First,
+                                               const char *const End) {
+#ifdef __SSE2__
+  const __m128i DoubleQuotes = _mm_set1_epi8('"');
+  const __m128i SingleQuotes = _mm_set1_epi8('\'');
+  const __m128i Backslashes = _mm_set1_epi8('\\');
+  const __m128i Slashes = _mm_set1_epi8('/');
+  const __m128i Newlines = _mm_set1_epi8('\n');
+  const __m128i Returns = _mm_set1_epi8('\r');
+  while (End - First >= 16) {
+    __m128i Cv = _mm_loadu_si128((const __m128i *)First);
+    __m128i Quotes = _mm_or_si128(_mm_cmpeq_epi8(Cv, DoubleQuotes),
+                                  _mm_cmpeq_epi8(Cv, SingleQuotes));
+    __m128i Escapes = _mm_or_si128(_mm_cmpeq_epi8(Cv, Backslashes),
+                                   _mm_cmpeq_epi8(Cv, Slashes));
+    __m128i EOLs = _mm_or_si128(_mm_cmpeq_epi8(Cv, Newlines),
+                                _mm_cmpeq_epi8(Cv, Returns));
+    unsigned Mask = _mm_movemask_epi8(
+        _mm_or_si128(_mm_or_si128(Quotes, Escapes), EOLs));
+    if (Mask != 0)
+      return First + llvm::countr_zero(Mask);
+    First += 16;
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  const uint8x16_t DoubleQuotes = vdupq_n_u8('"');
+  const uint8x16_t SingleQuotes = vdupq_n_u8('\'');
+  const uint8x16_t Backslashes = vdupq_n_u8('\\');
+  const uint8x16_t Slashes = vdupq_n_u8('/');
+  const uint8x16_t Newlines = vdupq_n_u8('\n');
+  const uint8x16_t Returns = vdupq_n_u8('\r');
+  while (End - First >= 16) {
+    uint8x16_t Cv = vld1q_u8((const uint8_t *)First);
+    uint8x16_t Quotes =
+        vorrq_u8(vceqq_u8(Cv, DoubleQuotes), vceqq_u8(Cv, SingleQuotes));
+    uint8x16_t Escapes =
+        vorrq_u8(vceqq_u8(Cv, Backslashes), vceqq_u8(Cv, Slashes));
+    uint8x16_t EOLs = vorrq_u8(vceqq_u8(Cv, Newlines), vceqq_u8(Cv, Returns));
+    if (vmaxvq_u8(vorrq_u8(vorrq_u8(Quotes, Escapes), EOLs)) != 0)
+      break;
+    First += 16;
+  }
+#endif
+  (void)End;
+  return First;
+}
+
 void Scanner::skipLine(const char *&First, const char *const End) {
   for (;;) {
     assert(First <= End);
@@ -433,6 +489,20 @@ void Scanner::skipLine(const char *&First, const char *const End) {
     // before a new-line character:
     char LastNonWhitespace = ' ';
     while (First != End && !isVerticalWhitespace(*First)) {
+      // Skip runs of characters that can't start a string, comment or line
+      // continuation in bulk.
+      if (const char *Next = findNextSkipLineSpecialChar(First, End);
+          Next != First) {
+        LastTokenPtr = Next - 1;
+        for (const char *Cur = Next; Cur != First;)
+          if (!isWhitespace(*--Cur)) {
+            LastNonWhitespace = *Cur;
+            break;
+          }
+        First = Next;
+        continue;
+      }
+
       // Iterate over strings correctly to avoid comments and newlines.
       if (*First == '"' ||
           (*First == '\'' && !isQuoteCppDigitSeparator(Start, First, End))) {
@@ -2576,6 +2576,58 @@ bool Lexer::SkipWhitespace(Token &Result, const char *CurPtr,
   return false;
 }
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#elif __ALTIVEC__
+#include <altivec.h>
+#undef bool
+#endif
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+/// Skip the leading run of plain ASCII bytes in a line comment body, sixteen
+/// bytes at a time. Returns a pointer at or before the first byte that the
+/// scalar loop in SkipLineComment needs to look at: a newline, a carriage
+/// return, a nul or a non-ASCII byte.
+static const char *
+fastSkipLineCommentBody(const char *CurPtr,
+                        [[maybe_unused]] const char *BufferEnd) {
+#ifdef __SSE2__
+  const __m128i Newlines = _mm_set1_epi8('\n');
+  const __m128i Returns = _mm_set1_epi8('\r');
+  const __m128i Zeros = _mm_setzero_si128();
+  while (BufferEnd - CurPtr >= 16) {
+    __m128i Cv = _mm_loadu_si128((const __m128i *)CurPtr);
+    __m128i Stop = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(Cv, Newlines), _mm_cmpeq_epi8(Cv, Returns)),
+        _mm_cmpeq_epi8(Cv, Zeros));
+    // Non-ASCII bytes have their top bit set, so OR-ing in the data itself
+    // makes them show up in the mask as well.
+    unsigned Mask = _mm_movemask_epi8(_mm_or_si128(Stop, Cv));
+    if (Mask != 0)
+      return CurPtr + llvm::countr_zero(Mask);
+    CurPtr += 16;
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  const uint8x16_t Newlines = vdupq_n_u8('\n');
+  const uint8x16_t Returns = vdupq_n_u8('\r');
+  const uint8x16_t HighBit = vdupq_n_u8(0x80);
+  while (BufferEnd - CurPtr >= 16) {
+    uint8x16_t Cv = vld1q_u8((const uint8_t *)CurPtr);
+    uint8x16_t Stop =
+        vorrq_u8(vorrq_u8(vceqq_u8(Cv, Newlines), vceqq_u8(Cv, Returns)),
+                 vorrq_u8(vceqzq_u8(Cv), vcgeq_u8(Cv, HighBit)));
+    // The scalar loop finds the exact position within this chunk.
+    if (vmaxvq_u8(Stop) != 0)
+      break;
+    CurPtr += 16;
+  }
+#endif
+  return CurPtr;
+}
+
 /// We have just read the // characters from input.  Skip until we find the
 /// newline character that terminates the comment.  Then update BufferPtr and
 /// return.
@@ -2610,6 +2662,13 @@ bool Lexer::SkipLineComment(Token &Result, const char *CurPtr,
 
   char C;
   while (true) {
+    // Skip over plain ASCII a register at a time before dropping into the
+    // byte-wise loop below.
+    const char *FastStart = CurPtr;
+    CurPtr = fastSkipLineCommentBody(CurPtr, BufferEnd);
+    if (CurPtr != FastStart)
+      UnicodeDecodingAlreadyDiagnosed = false;
+
     C = *CurPtr;
     // Skip over characters in the fast loop.
     while (isASCII(C) && C != 0 &&   // Potentially EOF.
@@ -2848,13 +2907,6 @@ static bool isEndOfBlockCommentWithEscapedNewLine(const char *CurPtr, Lexer *L,
   return true;
 }
 
-#ifdef __SSE2__
-#include <emmintrin.h>
-#elif __ALTIVEC__
-#include <altivec.h>
-#undef bool
-#endif
-
 /// We have just read from input the / and * characters that started a comment.
 /// Read until we find the * and / characters that terminate the comment.
 /// Note that we don't bother decoding trigraphs or escaped newlines in block
@@ -1721,6 +1721,29 @@ int ASTReader::getSLocEntryID(SourceLocation::UIntTy SLocOffset) {
          "Corrupted global sloc offset map");
   ModuleFile *F = SLocMapI->second;
 
+  // Returns the start offset of the given entry if it has been read already.
+  auto GetLoadedOffset =
+      [&](unsigned LocalIndex) -> std::optional<SourceLocation::UIntTy> {
+    std::size_t Index = -(F->SLocEntryBaseID + int(LocalIndex)) - 2;
+    if (!SourceMgr.SLocEntryOffsetLoaded[Index])
+      return std::nullopt;
+    return SourceMgr.LoadedSLocEntryTable[Index].getOffset();
+  };
+
+  // Try the entry found by the previous lookup before falling back to the
+  // binary search, which may have to read entry offsets from the AST file.
+  unsigned Last = F->LastSLocEntryLookup;
+  if (Last < F->LocalNumSLocEntries) {
+    std::optional<SourceLocation::UIntTy> Begin = GetLoadedOffset(Last);
+    if (Begin && *Begin <= SLocOffset) {
+      if (Last + 1 == F->LocalNumSLocEntries)
+        return F->SLocEntryBaseID + Last;
+      std::optional<SourceLocation::UIntTy> End = GetLoadedOffset(Last + 1);
+      if (End && SLocOffset < *End)
+        return F->SLocEntryBaseID + Last;
+    }
+  }
+
   bool Invalid = false;
 
   auto It = llvm::upper_bound(
@@ -1748,7 +1771,8 @@ int ASTReader::getSLocEntryID(SourceLocation::UIntTy SLocOffset) {
 
   // The iterator points to the first entry with start offset greater than the
   // offset of interest. The previous entry must contain the offset of interest.
-  return F->SLocEntryBaseID + *std::prev(It);
+  F->LastSLocEntryLookup = *std::prev(It);
+  return F->SLocEntryBaseID + F->LastSLocEntryLookup;
 }
 
 bool ASTReader::ReadSLocEntry(int ID) {
@@ -2709,15 +2733,8 @@ InputFile ASTReader::getInputFile(ModuleFile &F, unsigned ID, bool Complain) {
   if (F.InputFilesLoaded[ID-1].isNotFound())
     return InputFile();
 
-  // Go find this input file.
-  BitstreamCursor &Cursor = F.InputFilesCursor;
-  SavedStreamPosition SavedPosition(Cursor);
-  if (llvm::Error Err = Cursor.JumpToBit(F.InputFilesOffsetBase +
-                                         F.InputFileOffsets[ID - 1])) {
-    // FIXME this drops errors on the floor.
-    consumeError(std::move(Err));
-  }
-
+  // getInputFileInfo() positions the input files cursor itself, and only when
+  // the record hasn't been decoded yet.
   InputFileInfo FI = getInputFileInfo(F, ID);
   off_t StoredSize = FI.StoredSize;
   time_t StoredTime = FI.StoredTime;
@@ -3103,6 +3120,10 @@ ASTReader::ReadControlBlock(ModuleFile &F,
             F.Kind == MK_ImplicitModule)
           N = ForceValidateUserInputs ? NumUserInputs : 0;
 
+        // FIXME: Validation is a stat() per input file and dominates loading
+        // for modules with many inputs. Doing it concurrently needs FileManager,
+        // the VFS and the diagnostics engine to tolerate concurrent callers,
+        // which none of them currently do.
         for (unsigned I = 0; I < N; ++I) {
           InputFile IF = getInputFile(F, I+1, Complain);
           if (!IF.getFile() || IF.isOutOfDate())
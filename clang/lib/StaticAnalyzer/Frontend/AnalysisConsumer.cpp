@@ -690,6 +690,7 @@ AnalysisConsumer::getModeForDecl(Decl *D, AnalysisMode Mode) {
 }
 
 static UnsignedEPStat PathRunningTime("PathRunningTime");
+static UnsignedEPStat PathAllocatedKiB("PathAllocatedKiB");
 
 void AnalysisConsumer::HandleCode(Decl *D, AnalysisMode Mode,
                                   ExprEngine::InliningModes IMode,
@@ -773,6 +774,9 @@ void AnalysisConsumer::RunPathSensitiveChecks(Decl *D,
     ExprEngineEndTime -= ExprEngineStartTime;
     DisplayTime(ExprEngineEndTime);
   }
+  // Nodes and program states share the graph's allocator; record its size
+  // so that memory-hungry entry points can be told apart.
+  PathAllocatedKiB.set(Eng.getGraph().getAllocator().getTotalMemory() / 1024);
 
   if (!Mgr->options.DumpExplodedGraphTo.empty())
     Eng.DumpGraph(Mgr->options.TrimGraph, Mgr->options.DumpExplodedGraphTo);
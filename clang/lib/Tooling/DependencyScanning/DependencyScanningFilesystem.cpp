@@ -7,8 +7,11 @@
 //===----------------------------------------------------------------------===//
 
 #include "clang/Tooling/DependencyScanning/DependencyScanningFilesystem.h"
+#include "clang/Basic/Version.h"
+#include "llvm/Support/EndianStream.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Threading.h"
+#include "llvm/Support/xxhash.h"
 #include <optional>
 
 using namespace clang;
@@ -61,6 +64,15 @@ bool DependencyScanningWorkerFilesystem::ensureDirectiveTokensArePopulated(
     return true;
 
   SmallVector<dependency_directives_scan::Directive, 64> Directives;
+  // Reuse the result of a previous invocation if the file did not change.
+  if (SharedCache.getPersistentDirectives(
+          Entry.getStatus(), Contents->Original->getBuffer(),
+          Contents->DepDirectiveTokens, Directives)) {
+    Contents->DepDirectives.store(
+        new std::optional<DependencyDirectivesTy>(std::move(Directives)));
+    return true;
+  }
+
   // Scan the file for preprocessor directives that might affect the
   // dependencies.
   if (scanSourceForDependencyDirectives(Contents->Original->getBuffer(),
@@ -142,6 +154,226 @@ DependencyScanningFilesystemSharedCache::getOutOfDateEntries(
   return InvalidDiagInfo;
 }
 
+/// \returns true if \p Entry, cached for \p Path, no longer describes the file
+/// at \p Path on \p UnderlyingFS.
+static bool isEntryOutOfDate(StringRef Path, const CachedFileSystemEntry &Entry,
+                             llvm::vfs::FileSystem &UnderlyingFS) {
+  llvm::ErrorOr<llvm::vfs::Status> Status = UnderlyingFS.status(Path);
+  if (Entry.isError() || !Status)
+    return Entry.isError() != !Status;
+  llvm::vfs::Status CachedStatus = Entry.getStatus();
+  if (CachedStatus.getUniqueID() != Status->getUniqueID() ||
+      CachedStatus.isDirectory() != Status->isDirectory())
+    return true;
+  // Adding or removing files changes the modification time of a directory.
+  // Lookups of files that did not exist are checked through their negative
+  // entries instead.
+  return !Status->isDirectory() &&
+         (CachedStatus.getSize() != Status->getSize() ||
+          CachedStatus.getLastModificationTime() !=
+              Status->getLastModificationTime());
+}
+
+bool DependencyScanningFilesystemSharedCache::hasChangedEntries(
+    llvm::vfs::FileSystem &UnderlyingFS) const {
+  // Entries are never removed or modified once inserted, so they can be
+  // inspected after the shard lock is released.
+  std::vector<std::pair<std::string, const CachedFileSystemEntry *>> Entries;
+  for (unsigned i = 0; i < NumShards; i++) {
+    const CacheShard &Shard = CacheShards[i];
+    std::lock_guard<std::mutex> LockGuard(Shard.CacheLock);
+    for (const auto &[Path, CachedPair] : Shard.CacheByFilename)
+      if (CachedPair.first)
+        Entries.emplace_back(Path.str(), CachedPair.first);
+  }
+
+  for (const auto &[Path, Entry] : Entries)
+    if (isEntryOutOfDate(Path, *Entry, UnderlyingFS))
+      return true;
+  return false;
+}
+
+// The persistent directives file is a header followed by one record per file:
+//
+//   header:    "CLSDDIRS" u32:version u32:N char[N]:clang-version u64:count
+//   record:    u64:device u64:file u64:mtime u64:size u64:content-hash
+//              u32:ntokens u32:ndirs
+//              token[ntokens]  (u32:offset u32:length u16:kind u16:flags)
+//              directive[ndirs] (u32:kind u32:first-token u32:ntokens)
+//
+// All integers are little-endian. The clang version is part of the header
+// because token kinds are not stable across releases. The content hash catches
+// edits that keep the size and modification time of a file, for example within
+// the timestamp granularity of the filesystem.
+static constexpr llvm::StringLiteral PersistentMagic("CLSDDIRS");
+static constexpr uint32_t PersistentVersion = 2;
+static constexpr size_t PersistentRecordHeaderSize = 5 * 8 + 2 * 4;
+static constexpr size_t PersistentTokenSize = 4 + 4 + 2 + 2;
+static constexpr size_t PersistentDirectiveSize = 3 * 4;
+
+static uint64_t getModificationTimeForPersistence(const llvm::vfs::Status &S) {
+  return S.getLastModificationTime().time_since_epoch().count();
+}
+
+void DependencyScanningFilesystemSharedCache::readPersistentDirectives(
+    StringRef Path) {
+  using namespace llvm::support;
+  PersistentEntries.clear();
+  PersistentBuffer.reset();
+
+  auto BufOrErr = llvm::MemoryBuffer::getFile(Path, /*IsText=*/false,
+                                              /*RequiresNullTerminator=*/false);
+  if (!BufOrErr)
+    return;
+  std::unique_ptr<llvm::MemoryBuffer> Buf = std::move(*BufOrErr);
+  StringRef Data = Buf->getBuffer();
+
+  auto Consume = [&](size_t N) -> const char * {
+    if (Data.size() < N)
+      return nullptr;
+    const char *P = Data.data();
+    Data = Data.drop_front(N);
+    return P;
+  };
+
+  std::string ClangVersion = getClangFullVersion();
+  const char *P = Consume(PersistentMagic.size() + 8);
+  if (!P || StringRef(P, PersistentMagic.size()) != PersistentMagic ||
+      endian::read32le(P + 8) != PersistentVersion ||
+      endian::read32le(P + 12) != ClangVersion.size())
+    return;
+  P = Consume(ClangVersion.size());
+  if (!P || StringRef(P, ClangVersion.size()) != ClangVersion)
+    return;
+  if (!(P = Consume(8)))
+    return;
+  uint64_t Count = endian::read64le(P);
+
+  llvm::DenseMap<llvm::sys::fs::UniqueID, PersistentEntry> Entries;
+  for (uint64_t I = 0; I != Count; ++I) {
+    if (!(P = Consume(PersistentRecordHeaderSize)))
+      return;
+    llvm::sys::fs::UniqueID UID(endian::read64le(P), endian::read64le(P + 8));
+    PersistentEntry E;
+    E.ModificationTime = endian::read64le(P + 16);
+    E.Size = endian::read64le(P + 24);
+    E.ContentHash = endian::read64le(P + 32);
+    E.NumTokens = endian::read32le(P + 40);
+    E.NumDirectives = endian::read32le(P + 44);
+    E.Data = Consume(uint64_t(E.NumTokens) * PersistentTokenSize +
+                     uint64_t(E.NumDirectives) * PersistentDirectiveSize);
+    if (!E.Data)
+      return;
+    Entries[UID] = E;
+  }
+
+  PersistentEntries = std::move(Entries);
+  PersistentBuffer = std::move(Buf);
+}
+
+bool DependencyScanningFilesystemSharedCache::getPersistentDirectives(
+    const llvm::vfs::Status &Stat, StringRef Contents,
+    SmallVectorImpl<dependency_directives_scan::Token> &Tokens,
+    SmallVectorImpl<dependency_directives_scan::Directive> &Directives) const {
+  using namespace llvm::support;
+  auto It = PersistentEntries.find(Stat.getUniqueID());
+  if (It == PersistentEntries.end())
+    return false;
+  const PersistentEntry &E = It->second;
+  if (E.ModificationTime != getModificationTimeForPersistence(Stat) ||
+      E.Size != Stat.getSize() || E.Size != Contents.size() ||
+      E.ContentHash != llvm::xxh3_64bits(Contents))
+    return false;
+
+  const char *P = E.Data;
+  Tokens.clear();
+  Tokens.reserve(E.NumTokens);
+  for (uint32_t I = 0; I != E.NumTokens; ++I, P += PersistentTokenSize) {
+    uint32_t Offset = endian::read32le(P);
+    uint32_t Length = endian::read32le(P + 4);
+    if (uint64_t(Offset) + Length > E.Size) {
+      Tokens.clear();
+      return false;
+    }
+    Tokens.emplace_back(Offset, Length,
+                        static_cast<tok::TokenKind>(endian::read16le(P + 8)),
+                        endian::read16le(P + 10));
+  }
+
+  Directives.clear();
+  for (uint32_t I = 0; I != E.NumDirectives;
+       ++I, P += PersistentDirectiveSize) {
+    uint32_t First = endian::read32le(P + 4);
+    uint32_t Count = endian::read32le(P + 8);
+    if (uint64_t(First) + Count > Tokens.size()) {
+      Tokens.clear();
+      Directives.clear();
+      return false;
+    }
+    Directives.emplace_back(
+        static_cast<dependency_directives_scan::DirectiveKind>(
+            endian::read32le(P)),
+        ArrayRef(Tokens).slice(First, Count));
+  }
+  return true;
+}
+
+llvm::Error DependencyScanningFilesystemSharedCache::writePersistentDirectives(
+    StringRef Path) const {
+  return llvm::writeToOutput(Path, [&](raw_ostream &OS) -> llvm::Error {
+    llvm::support::endian::Writer W(OS, llvm::endianness::little);
+    std::string ClangVersion = getClangFullVersion();
+
+    // Collect the records first, the header needs their count.
+    SmallVector<const CachedFileSystemEntry *, 0> Entries;
+    for (unsigned I = 0; I != NumShards; ++I) {
+      const CacheShard &Shard = CacheShards[I];
+      std::lock_guard<std::mutex> LockGuard(Shard.CacheLock);
+      for (const auto &[UID, Entry] : Shard.EntriesByUID) {
+        if (Entry->isError() || Entry->isDirectory() ||
+            !Entry->getDirectiveTokens())
+          continue;
+        Entries.push_back(Entry);
+      }
+    }
+
+    OS << PersistentMagic;
+    W.write<uint32_t>(PersistentVersion);
+    W.write<uint32_t>(ClangVersion.size());
+    OS << ClangVersion;
+    W.write<uint64_t>(Entries.size());
+
+    for (const CachedFileSystemEntry *Entry : Entries) {
+      llvm::vfs::Status Stat = Entry->getStatus();
+      ArrayRef<dependency_directives_scan::Token> Tokens =
+          Entry->getCachedContents()->DepDirectiveTokens;
+      ArrayRef<dependency_directives_scan::Directive> Directives =
+          *Entry->getDirectiveTokens();
+
+      W.write<uint64_t>(Stat.getUniqueID().getDevice());
+      W.write<uint64_t>(Stat.getUniqueID().getFile());
+      W.write<uint64_t>(getModificationTimeForPersistence(Stat));
+      W.write<uint64_t>(Stat.getSize());
+      W.write<uint64_t>(llvm::xxh3_64bits(Entry->getOriginalContents()));
+      W.write<uint32_t>(Tokens.size());
+      W.write<uint32_t>(Directives.size());
+      for (const dependency_directives_scan::Token &T : Tokens) {
+        W.write<uint32_t>(T.Offset);
+        W.write<uint32_t>(T.Length);
+        W.write<uint16_t>(T.Kind);
+        W.write<uint16_t>(T.Flags);
+      }
+      for (const dependency_directives_scan::Directive &D : Directives) {
+        W.write<uint32_t>(D.Kind);
+        W.write<uint32_t>(D.Tokens.empty() ? 0
+                                           : D.Tokens.data() - Tokens.data());
+        W.write<uint32_t>(D.Tokens.size());
+      }
+    }
+    return llvm::Error::success();
+  });
+}
+
 const CachedFileSystemEntry *
 DependencyScanningFilesystemSharedCache::CacheShard::findEntryByFilename(
     StringRef Filename) const {
@@ -258,6 +490,17 @@ DependencyScanningWorkerFilesystem::getOrEmplaceSharedEntryForUID(
                                        std::move(TEntry.Contents));
 }
 
+bool DependencyScanningWorkerFilesystem::hasChangedEntries(
+    llvm::vfs::FileSystem &UnderlyingFS) const {
+  bool Changed = false;
+  LocalCache.forEachEntry(
+      [&](StringRef Filename, const CachedFileSystemEntry &Entry) {
+        if (!Changed)
+          Changed = isEntryOutOfDate(Filename, Entry, UnderlyingFS);
+      });
+  return Changed;
+}
+
 const CachedFileSystemEntry *
 DependencyScanningWorkerFilesystem::findEntryByFilenameWithWriteThrough(
     StringRef Filename) {
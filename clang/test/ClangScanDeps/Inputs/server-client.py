@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+"""Drives a 'clang-scan-deps -server' process for the server mode tests.
+
+Usage: server-client.py <requests> <socket> <clang-scan-deps command...>
+
+Starts the server, then handles the lines of <requests> in order:
+
+  write <path> <text>  writes <text> followed by a newline to <path>
+  oversize <n>         sends a request of <n> bytes without a newline
+  <JSON object>        sends the object as one request
+
+and prints the "dependencies" or "error" of each reply. Finally asks the
+server to shut down and exits with its exit code.
+"""
+
+import json
+import os
+import socket
+import subprocess
+import sys
+import time
+
+
+def connect(path, server):
+    for _ in range(600):
+        if server.poll() is not None:
+            sys.exit("server exited with %d" % server.returncode)
+        try:
+            sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+            sock.connect(path)
+            return sock
+        except OSError:
+            sock.close()
+            time.sleep(0.1)
+    sys.exit("cannot connect to " + path)
+
+
+def send(path, server, data):
+    sock = connect(path, server)
+    sock.sendall(data)
+    reply = b""
+    while not reply.endswith(b"\n"):
+        chunk = sock.recv(65536)
+        if not chunk:
+            break
+        reply += chunk
+    sock.close()
+    return json.loads(reply)
+
+
+def main():
+    requests, path = sys.argv[1:3]
+    server = subprocess.Popen(sys.argv[3:])
+    with open(requests) as f:
+        for line in f:
+            line = line.strip()
+            if not line:
+                continue
+            if line.startswith("write "):
+                _, file, text = line.split(" ", 2)
+                with open(file, "w") as out:
+                    out.write(text + "\n")
+                continue
+            if line.startswith("oversize "):
+                reply = send(path, server, b"x" * int(line.split()[1]))
+            else:
+                reply = send(path, server, line.encode() + b"\n")
+            if "dependencies" in reply:
+                print(reply["dependencies"])
+            else:
+                print("error: " + reply["error"])
+            sys.stdout.flush()
+    send(path, server, b'{"shutdown": true}\n')
+    sys.exit(server.wait())
+
+
+if __name__ == "__main__":
+    main()
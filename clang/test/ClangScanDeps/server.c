@@ -0,0 +1,49 @@
+// Test the server mode: replies honour -format, edits to files a request used
+// are picked up, and oversized requests are rejected.
+
+// REQUIRES: shell
+// UNSUPPORTED: system-windows
+
+// RUN: rm -rf %t && split-file %s %t
+// RUN: sed "s|DIR|%/t|g" %t/make.in > %t/make.txt
+// RUN: %python %S/Inputs/server-client.py %t/make.txt %t/make.sock \
+// RUN:   clang-scan-deps -server=%t/make.sock -format=make \
+// RUN:   | FileCheck %s -DPREFIX=%/t --check-prefix=MAKE
+
+// MAKE:      [[PREFIX]]/tu.o:
+// MAKE-NEXT:   [[PREFIX]]/tu.c
+// MAKE-NEXT:   [[PREFIX]]/a.h
+// MAKE-NOT:    b.h
+// MAKE:      [[PREFIX]]/tu.o:
+// MAKE-NEXT:   [[PREFIX]]/tu.c
+// MAKE-NEXT:   [[PREFIX]]/a.h
+// MAKE-NEXT:   [[PREFIX]]/b.h
+// MAKE:      error: request too large
+// MAKE:      error: expected 'directory' and 'arguments'
+
+// RUN: sed "s|DIR|%/t|g" %t/full.in > %t/full.txt
+// RUN: %python %S/Inputs/server-client.py %t/full.txt %t/full.sock \
+// RUN:   clang-scan-deps -server=%t/full.sock -format=experimental-full \
+// RUN:   | FileCheck %s -DPREFIX=%/t --check-prefix=FULL
+
+// FULL:      "translation-units": [
+// FULL:        "file-deps": [
+// FULL-NEXT:     "[[PREFIX]]/tu.c"
+// FULL:        "input-file": "[[PREFIX]]/tu.c"
+
+//--- tu.c
+#include "a.h"
+
+//--- a.h
+// a.h
+
+//--- make.in
+{"directory": "DIR", "arguments": ["clang", "-c", "DIR/tu.c", "-o", "DIR/tu.o"]}
+write DIR/b.h // b.h
+write DIR/a.h #include "b.h"
+{"directory": "DIR", "arguments": ["clang", "-c", "DIR/tu.c", "-o", "DIR/tu.o"]}
+oversize 16777217
+{"directory": "DIR"}
+
+//--- full.in
+{"directory": "DIR", "file": "DIR/tu.c", "arguments": ["clang", "-c", "DIR/tu.c", "-o", "DIR/tu.o"]}
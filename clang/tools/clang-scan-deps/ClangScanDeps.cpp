@@ -31,7 +31,10 @@
 #include "llvm/Support/Threading.h"
 #include "llvm/Support/Timer.h"
 #include "llvm/Support/VirtualFileSystem.h"
+#include "llvm/Support/raw_socket_stream.h"
 #include "llvm/TargetParser/Host.h"
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -94,6 +97,8 @@ static bool DeprecatedDriverCommand;
 static ResourceDirRecipeKind ResourceDirRecipe;
 static bool Verbose;
 static bool PrintTiming;
+static std::string PersistentCacheFile;
+static std::string ServerSocketPath;
 static llvm::BumpPtrAllocator Alloc;
 static llvm::StringSaver Saver{Alloc};
 static std::vector<const char *> CommandLine;
@@ -230,6 +235,12 @@ static void ParseArgs(int argc, char **argv) {
     ResourceDirRecipe = *Kind;
   }
 
+  if (const llvm::opt::Arg *A = Args.getLastArg(OPT_persistent_cache_EQ))
+    PersistentCacheFile = A->getValue();
+
+  if (const llvm::opt::Arg *A = Args.getLastArg(OPT_server_EQ))
+    ServerSocketPath = A->getValue();
+
   PrintTiming = Args.hasArg(OPT_print_timing);
 
   Verbose = Args.hasArg(OPT_verbose);
@@ -770,6 +781,10 @@ static std::unique_ptr<tooling::CompilationDatabase>
 getCompilationDatabase(int argc, char **argv, std::string &ErrorMessage) {
   ParseArgs(argc, argv);
 
+  // In server mode the command lines arrive with each request.
+  if (!ServerSocketPath.empty())
+    return nullptr;
+
   if (!(CommandLine.empty() ^ CompilationDB.empty())) {
     llvm::errs() << "The compilation command line must be provided either via "
                     "'-compilation-database' or after '--'.";
@@ -851,11 +866,252 @@ getCompilationDatabase(int argc, char **argv, std::string &ErrorMessage) {
       FEOpts.Inputs[0].getFile(), OutputFile, CommandLine);
 }
 
+/// The largest request the server mode accepts, to bound the memory a client
+/// can make it allocate.
+static constexpr size_t MaxServerRequestSize = 16 * 1024 * 1024;
+
+/// Scans the translation unit described by a server request in the output
+/// format selected with '-format'.
+static llvm::Expected<std::string>
+scanServerRequest(DependencyScanningTool &Tool,
+                  const std::vector<std::string> &Args, StringRef Directory,
+                  StringRef File, StringRef Output) {
+  std::string Result;
+  llvm::raw_string_ostream OS(Result);
+  switch (Format) {
+  case ScanningOutputFormat::Make:
+    return Tool.getDependencyFile(Args, Directory);
+  case ScanningOutputFormat::P1689: {
+    tooling::CompileCommand Command(Directory, File, Args, Output);
+    std::string MakeformatOutput;
+    std::string MakeformatOutputPath;
+    llvm::Expected<P1689Rule> Rule = Tool.getP1689ModuleDependencyFile(
+        Command, Directory, MakeformatOutput, MakeformatOutputPath);
+    if (!Rule)
+      return Rule.takeError();
+    if (!MakeformatOutputPath.empty() && !MakeformatOutput.empty())
+      if (llvm::Error E = llvm::writeToOutput(
+              MakeformatOutputPath, [&](raw_ostream &MakeOS) {
+                MakeOS << MakeformatOutput;
+                return llvm::Error::success();
+              }))
+        return std::move(E);
+    P1689Deps PD;
+    PD.addRules(*Rule);
+    PD.printDependencies(OS);
+    return Result;
+  }
+  case ScanningOutputFormat::Full: {
+    std::string OutputDir(ModuleFilesDir);
+    if (OutputDir.empty())
+      OutputDir = getModuleCachePath(Args);
+    auto LookupOutput = [&](const ModuleDeps &MD, ModuleOutputKind MOK) {
+      return ::lookupModuleOutput(MD, MOK, OutputDir);
+    };
+    llvm::Expected<TranslationUnitDeps> TUDeps =
+        Tool.getTranslationUnitDependencies(Args, Directory, {}, LookupOutput);
+    if (!TUDeps)
+      return TUDeps.takeError();
+    FullDeps FD(1);
+    FD.mergeDeps(File, std::move(*TUDeps), 0);
+    FD.printFullOutput(OS);
+    return Result;
+  }
+  }
+  llvm_unreachable("Fully covered switch above!");
+}
+
+namespace {
+/// Owns the DependencyScanningService of the server mode. Requests scan with
+/// the current service and then check the files they looked up; if any of them
+/// changed, the service is replaced and the request is scanned again. Requests
+/// still running on a replaced service keep it alive.
+class ServerCache {
+public:
+  ServerCache() : Service(createService()) {}
+
+  std::shared_ptr<DependencyScanningService> getService() {
+    std::lock_guard<std::mutex> Guard(Lock);
+    return Service;
+  }
+
+  /// Replaces \p Stale unless another request already did, and returns the
+  /// current service.
+  std::shared_ptr<DependencyScanningService>
+  replaceService(const std::shared_ptr<DependencyScanningService> &Stale) {
+    std::lock_guard<std::mutex> Guard(Lock);
+    if (Service == Stale) {
+      if (Verbose)
+        llvm::errs() << "clang-scan-deps: files changed, dropping the cache\n";
+      Service = createService();
+    }
+    return Service;
+  }
+
+private:
+  static std::shared_ptr<DependencyScanningService> createService() {
+    auto Service = std::make_shared<DependencyScanningService>(
+        ScanMode, Format, OptimizeArgs, EagerLoadModules, /*TraceVFS=*/false);
+    if (!PersistentCacheFile.empty())
+      Service->getSharedCache().readPersistentDirectives(PersistentCacheFile);
+    return Service;
+  }
+
+  std::mutex Lock;
+  std::shared_ptr<DependencyScanningService> Service;
+};
+} // namespace
+
+/// \returns true if a file that \p Tool looked up changed since it was cached.
+static bool hasChangedFiles(DependencyScanningTool &Tool) {
+  bool Changed = false;
+  Tool.getWorkerVFS().visit([&](llvm::vfs::FileSystem &VFS) {
+    if (auto *DFS = dyn_cast<DependencyScanningWorkerFilesystem>(&VFS))
+      Changed |= DFS->hasChangedEntries(*llvm::vfs::getRealFileSystem());
+  });
+  return Changed;
+}
+
+/// Handles a single request of the server mode. A request is one line holding
+/// a JSON object with the "directory" to run in and the full compiler command
+/// line as "arguments". The "file" being compiled and its "output" are only
+/// needed with '-format=p1689'. The reply is a JSON object with either the
+/// "dependencies" in the format selected with '-format' or an "error". A
+/// request of {"shutdown": true} stops the server.
+///
+/// \returns false if the server was asked to shut down.
+static bool handleServerRequest(ServerCache &Cache,
+                                llvm::raw_socket_stream &Conn) {
+  auto Reply = [&](StringRef Key, llvm::json::Value V) {
+    Conn << llvm::json::Value(llvm::json::Object{{Key, std::move(V)}}) << '\n';
+    Conn.flush();
+  };
+
+  std::string Request;
+  char Buffer[4096];
+  while (Request.find('\n') == std::string::npos) {
+    if (Request.size() > MaxServerRequestSize) {
+      Reply("error", "request too large");
+      return true;
+    }
+    ssize_t N = Conn.read(Buffer, sizeof(Buffer));
+    if (N <= 0)
+      break;
+    Request.append(Buffer, N);
+  }
+
+  llvm::Expected<llvm::json::Value> Parsed =
+      llvm::json::parse(StringRef(Request).split('\n').first);
+  if (!Parsed) {
+    Reply("error", llvm::toString(Parsed.takeError()));
+    return true;
+  }
+  const llvm::json::Object *Obj = Parsed->getAsObject();
+  if (!Obj) {
+    Reply("error", "expected a JSON object");
+    return true;
+  }
+  if (Obj->getBoolean("shutdown").value_or(false)) {
+    Reply("shutdown", true);
+    return false;
+  }
+
+  std::optional<StringRef> Directory = Obj->getString("directory");
+  const llvm::json::Array *Arguments = Obj->getArray("arguments");
+  if (!Directory || !Arguments) {
+    Reply("error", "expected 'directory' and 'arguments'");
+    return true;
+  }
+  std::vector<std::string> Args;
+  for (const llvm::json::Value &A : *Arguments) {
+    std::optional<StringRef> S = A.getAsString();
+    if (!S) {
+      Reply("error", "'arguments' must be strings");
+      return true;
+    }
+    Args.push_back(S->str());
+  }
+  StringRef File = Obj->getString("file").value_or("");
+  StringRef Output = Obj->getString("output").value_or("");
+
+  // Only the files this request looked up are checked for changes, so the
+  // cost of a request does not grow with the size of the shared cache. A scan
+  // on a fresh service only reads files after the request arrived, so its
+  // result is used as is.
+  std::shared_ptr<DependencyScanningService> Service = Cache.getService();
+  std::optional<llvm::Expected<std::string>> Deps;
+  for (unsigned Attempt = 0; Attempt != 2; ++Attempt) {
+    if (Deps)
+      llvm::consumeError(Deps->takeError());
+    DependencyScanningTool Tool(*Service);
+    Deps.emplace(scanServerRequest(Tool, Args, *Directory, File, Output));
+    if (!hasChangedFiles(Tool))
+      break;
+    Service = Cache.replaceService(Service);
+  }
+
+  if (!*Deps)
+    Reply("error", llvm::toString(Deps->takeError()));
+  else
+    Reply("dependencies", std::move(**Deps));
+  return true;
+}
+
+/// Runs clang-scan-deps as a long-lived server that keeps the shared
+/// filesystem and directives caches warm across requests.
+static int runServer(StringRef SocketPath) {
+  llvm::Expected<llvm::ListeningSocket> Socket =
+      llvm::ListeningSocket::createUnix(SocketPath);
+  if (!Socket) {
+    llvm::errs() << "error: cannot listen on '" << SocketPath
+                 << "': " << llvm::toString(Socket.takeError()) << "\n";
+    return 1;
+  }
+
+  ServerCache Cache;
+  llvm::DefaultThreadPool Pool(llvm::hardware_concurrency(NumThreads));
+  std::atomic<bool> ShutdownRequested = false;
+  int Result = 0;
+  while (!ShutdownRequested) {
+    // Wake up periodically to notice shutdown requests.
+    llvm::Expected<std::unique_ptr<llvm::raw_socket_stream>> Conn =
+        Socket->accept(std::chrono::milliseconds(500));
+    if (!Conn) {
+      std::error_code EC = llvm::errorToErrorCode(Conn.takeError());
+      if (EC == std::errc::timed_out ||
+          EC == std::errc::operation_would_block ||
+          EC == std::errc::interrupted)
+        continue;
+      llvm::errs() << "error: cannot accept on '" << SocketPath
+                   << "': " << EC.message() << "\n";
+      Result = 1;
+      break;
+    }
+
+    std::shared_ptr<llvm::raw_socket_stream> Stream = std::move(*Conn);
+    Pool.async([&Cache, Stream, &ShutdownRequested] {
+      if (!handleServerRequest(Cache, *Stream))
+        ShutdownRequested = true;
+    });
+  }
+  Pool.wait();
+
+  std::shared_ptr<DependencyScanningService> Service = Cache.getService();
+  if (!PersistentCacheFile.empty())
+    if (llvm::Error E = Service->getSharedCache().writePersistentDirectives(
+            PersistentCacheFile))
+      llvm::errs() << "warning: could not write '" << PersistentCacheFile
+                   << "': " << llvm::toString(std::move(E)) << "\n";
+  return Result;
+}
+
 int clang_scan_deps_main(int argc, char **argv, const llvm::ToolContext &) {
   llvm::InitializeAllTargetInfos();
   std::string ErrorMessage;
   std::unique_ptr<tooling::CompilationDatabase> Compilations =
       getCompilationDatabase(argc, argv, ErrorMessage);
+  if (!ServerSocketPath.empty())
+    return runServer(ServerSocketPath);
   if (!Compilations) {
     llvm::errs() << ErrorMessage << "\n";
     return 1;
@@ -1100,6 +1356,8 @@ int clang_scan_deps_main(int argc, char **argv, const llvm::ToolContext &) {
 
   DependencyScanningService Service(ScanMode, Format, OptimizeArgs,
                                     EagerLoadModules, /*TraceVFS=*/Verbose);
+  if (!PersistentCacheFile.empty())
+    Service.getSharedCache().readPersistentDirectives(PersistentCacheFile);
 
   llvm::Timer T;
   T.startTimer();
@@ -1123,6 +1381,12 @@ int clang_scan_deps_main(int argc, char **argv, const llvm::ToolContext &) {
 
   T.stopTimer();
 
+  if (!PersistentCacheFile.empty())
+    if (llvm::Error E = Service.getSharedCache().writePersistentDirectives(
+            PersistentCacheFile))
+      llvm::errs() << "warning: could not write '" << PersistentCacheFile
+                   << "': " << llvm::toString(std::move(E)) << "\n";
+
   if (Verbose)
     llvm::errs() << "\n*** Virtual File System Stats:\n"
                  << NumStatusCalls << " status() calls\n"
@@ -1151,6 +1151,22 @@ TEST(MinimizeSourceToDependencyDirectivesTest, ObjCMethodArgs) {
   EXPECT_STREQ("<TokBeforeEOF>\n", Out.data());
 }
 
+TEST(MinimizeSourceToDependencyDirectivesTest, LongNonDirectiveLines) {
+  SmallVector<char, 128> Out;
+
+  // Lines longer than a vector register exercise the bulk skipping in
+  // skipLine; the special characters land on and across chunk boundaries.
+  ASSERT_FALSE(minimizeSourceToDependencyDirectives(
+      "int a_rather_long_identifier = 0; // comment hiding #define X\n"
+      "const char *s = \"a long enough string with \\\" and // in it\";\n"
+      "int digits_with_separators = 1'000'000; char c = '\\'';\n"
+      "int another_long_identifier_name = 1 + 2 + 3 + \\\n"
+      "#define NOT_A_DIRECTIVE\n"
+      "#include <A>\n",
+      Out));
+  EXPECT_STREQ("#include <A>\n", Out.data());
+}
+
 TEST(MinimizeSourceToDependencyDirectivesTest, TokensBeforeEOF) {
   SmallString<128> Out;
 
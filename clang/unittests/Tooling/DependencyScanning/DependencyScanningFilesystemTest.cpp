@@ -8,6 +8,8 @@
 
 #include "clang/Tooling/DependencyScanning/DependencyScanningFilesystem.h"
 #include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/FileUtilities.h"
 #include "llvm/Support/VirtualFileSystem.h"
 #include "gtest/gtest.h"
 
@@ -233,3 +235,112 @@ TEST(DependencyScanningFilesystem, DiagnoseCachedFileSizeChange) {
   ASSERT_EQ(SizeInfo->CachedSize, 0u);
   ASSERT_EQ(SizeInfo->ActualSize, 8u);
 }
+
+TEST(DependencyScanningFilesystem, HasChangedEntries) {
+  auto InMemoryFS = llvm::makeIntrusiveRefCnt<llvm::vfs::InMemoryFileSystem>();
+  InMemoryFS->setCurrentWorkingDirectory("/");
+  InMemoryFS->addFile("/file.h", 0, llvm::MemoryBuffer::getMemBuffer("a"));
+
+  DependencyScanningFilesystemSharedCache SharedCache;
+  DependencyScanningWorkerFilesystem DepFS(SharedCache, InMemoryFS);
+  ASSERT_TRUE(DepFS.exists("/file.h"));
+  ASSERT_FALSE(DepFS.exists("/missing.h"));
+  EXPECT_FALSE(SharedCache.hasChangedEntries(*InMemoryFS));
+
+  // Same size, different contents and modification time.
+  auto EditedFS = llvm::makeIntrusiveRefCnt<llvm::vfs::InMemoryFileSystem>();
+  EditedFS->setCurrentWorkingDirectory("/");
+  EditedFS->addFile("/file.h", 1, llvm::MemoryBuffer::getMemBuffer("b"));
+  EXPECT_TRUE(SharedCache.hasChangedEntries(*EditedFS));
+
+  // The cached file was removed.
+  auto EmptyFS = llvm::makeIntrusiveRefCnt<llvm::vfs::InMemoryFileSystem>();
+  EmptyFS->setCurrentWorkingDirectory("/");
+  EXPECT_TRUE(SharedCache.hasChangedEntries(*EmptyFS));
+
+  // A file that was cached as missing now exists.
+  InMemoryFS->addFile("/missing.h", 0, llvm::MemoryBuffer::getMemBuffer(""));
+  EXPECT_TRUE(SharedCache.hasChangedEntries(*InMemoryFS));
+}
+
+TEST(DependencyScanningFilesystem, WorkerHasChangedEntries) {
+  auto InMemoryFS = llvm::makeIntrusiveRefCnt<llvm::vfs::InMemoryFileSystem>();
+  InMemoryFS->setCurrentWorkingDirectory("/");
+  InMemoryFS->addFile("/used.h", 0, llvm::MemoryBuffer::getMemBuffer("a"));
+  InMemoryFS->addFile("/other.h", 0, llvm::MemoryBuffer::getMemBuffer("a"));
+
+  DependencyScanningFilesystemSharedCache SharedCache;
+  DependencyScanningWorkerFilesystem DepFS1(SharedCache, InMemoryFS);
+  ASSERT_TRUE(DepFS1.exists("/used.h"));
+  DependencyScanningWorkerFilesystem DepFS2(SharedCache, InMemoryFS);
+  ASSERT_TRUE(DepFS2.exists("/other.h"));
+  ASSERT_FALSE(DepFS2.exists("/missing.h"));
+
+  // Only the entries a worker looked up are checked.
+  auto EditedFS = llvm::makeIntrusiveRefCnt<llvm::vfs::InMemoryFileSystem>();
+  EditedFS->setCurrentWorkingDirectory("/");
+  EditedFS->addFile("/used.h", 0, llvm::MemoryBuffer::getMemBuffer("a"));
+  EditedFS->addFile("/other.h", 1, llvm::MemoryBuffer::getMemBuffer("b"));
+  EXPECT_FALSE(DepFS1.hasChangedEntries(*EditedFS));
+  EXPECT_TRUE(DepFS2.hasChangedEntries(*EditedFS));
+
+  // A file that the worker cached as missing now exists.
+  InMemoryFS->addFile("/missing.h", 0, llvm::MemoryBuffer::getMemBuffer(""));
+  EXPECT_FALSE(DepFS1.hasChangedEntries(*InMemoryFS));
+  EXPECT_TRUE(DepFS2.hasChangedEntries(*InMemoryFS));
+}
+
+TEST(DependencyScanningFilesystem, PersistentDirectives) {
+  using namespace clang::dependency_directives_scan;
+  auto InMemoryFS1 = llvm::makeIntrusiveRefCnt<llvm::vfs::InMemoryFileSystem>();
+  InMemoryFS1->addFile("/header.h", 0,
+                       llvm::MemoryBuffer::getMemBuffer("#define A 1\n"));
+
+  llvm::SmallString<128> CachePath;
+  ASSERT_FALSE(llvm::sys::fs::createTemporaryFile("scan-deps", "cache",
+                                                  CachePath));
+  llvm::FileRemover Cleanup(CachePath);
+
+  {
+    DependencyScanningFilesystemSharedCache SharedCache;
+    DependencyScanningWorkerFilesystem DepFS(SharedCache, InMemoryFS1);
+    auto Directives = DepFS.getDirectiveTokens("/header.h");
+    ASSERT_TRUE(Directives);
+    ASSERT_EQ(Directives->front().Kind, pp_define);
+    ASSERT_FALSE(llvm::errorToBool(
+        SharedCache.writePersistentDirectives(CachePath)));
+  }
+
+  // A file with the same unique ID, modification time and size reuses the
+  // persisted directives.
+  DependencyScanningFilesystemSharedCache SharedCache;
+  SharedCache.readPersistentDirectives(CachePath);
+  llvm::SmallVector<Token> Tokens;
+  llvm::SmallVector<Directive> Directives;
+  auto Stat = InMemoryFS1->status("/header.h");
+  ASSERT_TRUE(Stat);
+  ASSERT_TRUE(SharedCache.getPersistentDirectives(*Stat, "#define A 1\n",
+                                                  Tokens, Directives));
+  ASSERT_FALSE(Directives.empty());
+  EXPECT_EQ(Directives.front().Kind, pp_define);
+  EXPECT_FALSE(Directives.front().Tokens.empty());
+
+  DependencyScanningWorkerFilesystem DepFS(SharedCache, InMemoryFS1);
+  auto DepDirectives = DepFS.getDirectiveTokens("/header.h");
+  ASSERT_TRUE(DepDirectives);
+  EXPECT_EQ(DepDirectives->size(), Directives.size());
+
+  // Different contents with the same unique ID, modification time and size
+  // invalidate the persisted directives.
+  EXPECT_FALSE(SharedCache.getPersistentDirectives(*Stat, "#define B 1\n",
+                                                   Tokens, Directives));
+
+  // A different modification time invalidates the persisted directives.
+  auto InMemoryFS2 = llvm::makeIntrusiveRefCnt<llvm::vfs::InMemoryFileSystem>();
+  InMemoryFS2->addFile("/header.h", 1,
+                       llvm::MemoryBuffer::getMemBuffer("#define A 1\n"));
+  Stat = InMemoryFS2->status("/header.h");
+  ASSERT_TRUE(Stat);
+  EXPECT_FALSE(SharedCache.getPersistentDirectives(*Stat, "#define A 1\n",
+                                                   Tokens, Directives));
+}
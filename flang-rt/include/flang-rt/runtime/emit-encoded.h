@@ -97,11 +97,20 @@ RT_API_ATTRS bool EmitRepeated(CONTEXT &to, char ch, std::size_t n) {
   ConnectionState &connection{to.GetConnectionState()};
   if (connection.internalIoCharKind <= 1 &&
       connection.access != Access::Stream) {
-    // faster path, no encoding needed
-    while (n-- > 0) {
-      if (!to.Emit(&ch, 1)) {
+    // faster path, no encoding needed; emit in chunks so that padding
+    // doesn't pay the per-call record bookkeeping once per character
+    constexpr std::size_t chunkSize{32};
+    char chunk[chunkSize];
+    std::size_t fill{n < chunkSize ? n : chunkSize};
+    for (std::size_t j{0}; j < fill; ++j) {
+      chunk[j] = ch;
+    }
+    while (n > 0) {
+      std::size_t chars{n < chunkSize ? n : chunkSize};
+      if (!to.Emit(chunk, chars)) {
         return false;
       }
+      n -= chars;
     }
   } else {
     while (n-- > 0) {
@@ -73,6 +73,10 @@ private:
 //    DO 2 J = 1, NCOLS
 //     DO 2 I = 1, NROWS
 //   2  RES(I,J) = RES(I,J) + X(I,K)*Y(K,J) ! loop-invariant last term
+// The J loop is then strip-mined into panels of result columns small enough
+// to stay in cache across the whole K loop, so each pass over K re-reads a
+// resident panel of RES rather than streaming all of RES through memory.
+// Each element still accumulates its terms in increasing K order.
 template <TypeCategory RCAT, int RKIND, typename XT, typename YT,
     bool X_HAS_STRIDED_COLUMNS, bool Y_HAS_STRIDED_COLUMNS>
 inline RT_API_ATTRS void MatrixTimesMatrix(
@@ -82,28 +86,40 @@ inline RT_API_ATTRS void MatrixTimesMatrix(
     std::size_t yColumnByteStride = 0) {
   using ResultType = CppTypeFor<RCAT, RKIND>;
   std::memset(product, 0, rows * cols * sizeof *product);
-  const XT *RESTRICT xp0{x};
-  for (SubscriptValue k{0}; k < n; ++k) {
-    ResultType *RESTRICT p{product};
-    for (SubscriptValue j{0}; j < cols; ++j) {
-      const XT *RESTRICT xp{xp0};
-      ResultType yv;
-      if constexpr (!Y_HAS_STRIDED_COLUMNS) {
-        yv = static_cast<ResultType>(y[k + j * n]);
-      } else {
-        yv = static_cast<ResultType>(reinterpret_cast<const YT *>(
-            reinterpret_cast<const char *>(y) + j * yColumnByteStride)[k]);
+  constexpr std::size_t panelBytes{64 * 1024};
+  SubscriptValue panelCols{cols};
+  if (rows > 0) {
+    panelCols = static_cast<SubscriptValue>(
+        panelBytes / (rows * sizeof(ResultType)));
+    if (panelCols < 1) {
+      panelCols = 1;
+    }
+  }
+  for (SubscriptValue j0{0}; j0 < cols; j0 += panelCols) {
+    SubscriptValue jEnd{cols - j0 > panelCols ? j0 + panelCols : cols};
+    const XT *RESTRICT xp0{x};
+    for (SubscriptValue k{0}; k < n; ++k) {
+      ResultType *RESTRICT p{product + j0 * rows};
+      for (SubscriptValue j{j0}; j < jEnd; ++j) {
+        const XT *RESTRICT xp{xp0};
+        ResultType yv;
+        if constexpr (!Y_HAS_STRIDED_COLUMNS) {
+          yv = static_cast<ResultType>(y[k + j * n]);
+        } else {
+          yv = static_cast<ResultType>(reinterpret_cast<const YT *>(
+              reinterpret_cast<const char *>(y) + j * yColumnByteStride)[k]);
+        }
+        for (SubscriptValue i{0}; i < rows; ++i) {
+          *p++ += static_cast<ResultType>(*xp++) * yv;
+        }
       }
-      for (SubscriptValue i{0}; i < rows; ++i) {
-        *p++ += static_cast<ResultType>(*xp++) * yv;
+      if constexpr (!X_HAS_STRIDED_COLUMNS) {
+        xp0 += rows;
+      } else {
+        xp0 = reinterpret_cast<const XT *>(
+            reinterpret_cast<const char *>(xp0) + xColumnByteStride);
       }
     }
-    if constexpr (!X_HAS_STRIDED_COLUMNS) {
-      xp0 += rows;
-    } else {
-      xp0 = reinterpret_cast<const XT *>(
-          reinterpret_cast<const char *>(xp0) + xColumnByteStride);
-    }
   }
 }
 
@@ -25,10 +25,13 @@ public:
   RT_API_ATTRS void GetResult(A *p, int /*zeroBasedDim*/ = -1) const {
     *p = static_cast<A>(product_);
   }
+  template <typename A> RT_API_ATTRS bool Accumulate(A x) {
+    product_ *= x;
+    return product_ != 0;
+  }
   template <typename A>
   RT_API_ATTRS bool AccumulateAt(const SubscriptValue at[]) {
-    product_ *= *array_.Element<A>(at);
-    return product_ != 0;
+    return Accumulate(*array_.Element<A>(at));
   }
 
 private:
@@ -47,10 +50,13 @@ public:
     *p = {static_cast<ResultPart>(product_.real()),
         static_cast<ResultPart>(product_.imag())};
   }
+  template <typename A> RT_API_ATTRS bool Accumulate(const A &z) {
+    product_ *= z;
+    return true;
+  }
   template <typename A>
   RT_API_ATTRS bool AccumulateAt(const SubscriptValue at[]) {
-    product_ *= *array_.Element<A>(at);
-    return true;
+    return Accumulate(*array_.Element<A>(at));
   }
 
 private:
@@ -30,10 +30,13 @@ public:
   RT_API_ATTRS void GetResult(A *p, int /*zeroBasedDim*/ = -1) const {
     *p = static_cast<A>(sum_);
   }
+  template <typename A> RT_API_ATTRS bool Accumulate(A x) {
+    sum_ += x;
+    return true;
+  }
   template <typename A>
   RT_API_ATTRS bool AccumulateAt(const SubscriptValue at[]) {
-    sum_ += *array_.Element<A>(at);
-    return true;
+    return Accumulate(*array_.Element<A>(at));
   }
 
 private:
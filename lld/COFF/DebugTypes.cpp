@@ -586,18 +586,34 @@ void PrecompSource::registerMapping() {
 // Parellel GHash type merging implementation.
 //===----------------------------------------------------------------------===//
 
+// Faster way to iterate type records. forEachTypeChecked is faster than
+// iterating CVTypeArray. It avoids virtual readBytes calls in inner loops.
+static void forEachTypeChecked(ArrayRef<uint8_t> types,
+                               function_ref<void(const CVType &)> fn) {
+  checkError(
+      forEachCodeViewRecord<CVType>(types, [fn](const CVType &ty) -> Error {
+        fn(ty);
+        return Error::success();
+      }));
+}
+
 void TpiSource::loadGHashes() {
   if (std::optional<ArrayRef<uint8_t>> debugH = getDebugH(file)) {
     ghashes = getHashesFromDebugH(*debugH);
     ownedGHashes = false;
-  } else {
-    CVTypeArray types;
-    BinaryStreamReader reader(file->debugTypes, llvm::endianness::little);
-    cantFail(reader.readArray(types, reader.getLength()));
-    assignGHashesFromVector(GloballyHashedType::hashTypes(types));
+    fillIsItemIndexFromDebugT();
+    return;
   }
 
-  fillIsItemIndexFromDebugT();
+  // Split the records and fill in the isItemIndex bit vector in a single walk
+  // over .debug$T, then hash the records from a flat array, which avoids the
+  // virtual readBytes calls of iterating a CVTypeArray.
+  std::vector<CVType> types;
+  forEachTypeChecked(file->debugTypes, [&](const CVType &ty) {
+    isItemIndex.push_back(isIdRecord(ty.kind()));
+    types.push_back(ty);
+  });
+  assignGHashesFromVector(GloballyHashedType::hashTypes(types));
 }
 
 // Copies ghashes from a vector into an array. These are long lived, so it's
@@ -613,17 +629,6 @@ void TpiSource::assignGHashesFromVector(
   ownedGHashes = true;
 }
 
-// Faster way to iterate type records. forEachTypeChecked is faster than
-// iterating CVTypeArray. It avoids virtual readBytes calls in inner loops.
-static void forEachTypeChecked(ArrayRef<uint8_t> types,
-                               function_ref<void(const CVType &)> fn) {
-  checkError(
-      forEachCodeViewRecord<CVType>(types, [fn](const CVType &ty) -> Error {
-        fn(ty);
-        return Error::success();
-      }));
-}
-
 // Walk over file->debugTypes and fill in the isItemIndex bit vector.
 // TODO: Store this information in .debug$H so that we don't have to recompute
 // it. This is the main bottleneck slowing down parallel ghashing with one
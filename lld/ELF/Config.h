@@ -365,6 +365,7 @@ struct Config {
   bool rejectMismatch;
   bool relax;
   bool relaxGP;
+  bool releaseInputPages;
   bool relocatable;
   bool resolveGroups;
   bool relrGlibc = false;
@@ -373,6 +374,7 @@ struct Config {
   llvm::SmallVector<std::pair<llvm::GlobPattern, uint32_t>, 0> shuffleSections;
   bool singleRoRx;
   bool singleXoRx;
+  bool skipIfUnchanged;
   bool shared;
   bool symbolic;
   bool isStatic = false;
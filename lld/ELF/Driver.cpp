@@ -65,6 +65,7 @@
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
 #include <cstdlib>
 #include <tuple>
 #include <utility>
@@ -647,6 +648,200 @@ constexpr const char *saveTempsValues[] = {
 
 LinkerDriver::LinkerDriver(Ctx &ctx) : ctx(ctx) {}
 
+// --skip-if-unchanged keeps a state file next to the output. It records a hash
+// of the expanded command line, the hash of every input file read by the link
+// (including files loaded after createFiles(), such as .deplibs libraries and
+// lazily extracted thin archive members), and the size and modification time
+// of the output written by that link. If all of that still matches, the link
+// is skipped. Otherwise the inputs whose contents changed are logged and a full
+// link is performed.
+//
+// A library that would now be found earlier in the search path is not
+// detected, because only the files actually read by the previous link are
+// recorded.
+static std::string getSkipStatePath(Ctx &ctx) {
+  return (ctx.arg.outputFile + ".lld-skip-state").str();
+}
+
+// Hash the arguments after response file expansion, so that editing an @file
+// invalidates the state even though the command line itself is unchanged.
+static uint64_t hashArgs(const opt::InputArgList &args) {
+  std::string argsStr;
+  for (unsigned i = 0, e = args.getNumInputArgStrings(); i != e; ++i) {
+    argsStr += args.getArgString(i);
+    argsStr += '\0';
+  }
+  return xxh3_64bits(argsStr);
+}
+
+static std::string getSkipStateHeader(const opt::InputArgList &args) {
+  return ("lld-skip-state-v3\nversion " + Twine(xxh3_64bits(getLLDVersion())) +
+          "\nargs " + Twine(hashArgs(args)) + "\n")
+      .str();
+}
+
+// Hash ctx.memoryBuffers[begin..] in parallel and append the results to
+// hashes.
+static void hashInputs(Ctx &ctx, size_t begin,
+                       SmallVectorImpl<uint64_t> &hashes) {
+  hashes.resize(ctx.memoryBuffers.size());
+  parallelFor(begin, hashes.size(), [&](size_t i) {
+    hashes[i] = xxh3_64bits(ctx.memoryBuffers[i]->getBuffer());
+  });
+}
+
+// Returns the size and modification time of path.
+static std::optional<std::string> getFileStamp(StringRef path) {
+  sys::fs::file_status st;
+  if (sys::fs::status(path, st) || !sys::fs::exists(st))
+    return std::nullopt;
+  return (Twine(st.getSize()) + " " +
+          Twine(st.getLastModificationTime().time_since_epoch().count()))
+      .str();
+}
+
+static void
+getInputStamps(Ctx &ctx, SmallVectorImpl<std::optional<std::string>> &stamps) {
+  stamps.resize(ctx.memoryBuffers.size());
+  parallelFor(0, stamps.size(), [&](size_t i) {
+    stamps[i] = getFileStamp(ctx.memoryBuffers[i]->getBufferIdentifier());
+  });
+}
+
+// Skipping the link is only correct if the output file is its only effect.
+// Reports that are regenerated by every link force a link. A dependency file
+// only depends on the inputs, so it just has to still exist.
+static bool canSkipLink(Ctx &ctx, const opt::InputArgList &args) {
+  if (ctx.tar || ctx.arg.printGcSections || ctx.arg.printIcfSections ||
+      ctx.arg.printMemoryUsage || ctx.arg.trace ||
+      args.hasArg(OPT_trace_symbol) || !ctx.arg.mapFile.empty() ||
+      !ctx.arg.whyExtract.empty() || !ctx.arg.printArchiveStats.empty() ||
+      !ctx.arg.printSymbolOrder.empty() || !ctx.arg.optStatsFilename.empty())
+    return false;
+  StringRef depFile = ctx.arg.dependencyFile;
+  if (!depFile.empty() && (depFile == "-" || !sys::fs::exists(depFile))) {
+    Log(ctx) << "skip-if-unchanged: " << depFile << " must be regenerated";
+    return false;
+  }
+  return true;
+}
+
+// Returns true if the state recorded by the previous link still holds.
+// inputHashes holds the hashes of the inputs already loaded by createFiles();
+// the remaining files recorded by the previous link are read from disk.
+static bool isOutputUpToDate(Ctx &ctx, const opt::InputArgList &args,
+                             ArrayRef<uint64_t> inputHashes) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> mbOrErr =
+      MemoryBuffer::getFile(getSkipStatePath(ctx), /*IsText=*/true,
+                            /*RequiresNullTerminator=*/false);
+  if (!mbOrErr)
+    return false;
+  StringRef old = (*mbOrErr)->getBuffer();
+  if (!old.consume_front(getSkipStateHeader(args))) {
+    Log(ctx) << "skip-if-unchanged: options or linker version changed";
+    return false;
+  }
+
+  SmallVector<StringRef, 0> lines;
+  old.split(lines, '\n', /*MaxSplit=*/-1, /*KeepEmpty=*/false);
+  SmallVector<std::pair<StringRef, StringRef>, 0> oldInputs;
+  StringRef oldStamp;
+  for (StringRef line : lines) {
+    if (line.consume_front("input "))
+      oldInputs.push_back(line.split(' '));
+    else if (line.starts_with("output "))
+      oldStamp = line;
+    else
+      return false;
+  }
+
+  DenseMap<StringRef, uint64_t> loaded;
+  for (auto [mb, hash] : llvm::zip_equal(ctx.memoryBuffers, inputHashes))
+    loaded[mb->getBufferIdentifier()] = hash;
+
+  // A file loaded now that the previous link did not read means the inputs
+  // changed.
+  DenseSet<StringRef> oldPaths;
+  for (auto [hash, path] : oldInputs)
+    oldPaths.insert(path);
+  bool upToDate = true;
+  for (auto &[path, hash] : loaded) {
+    if (!oldPaths.contains(path)) {
+      Log(ctx) << "skip-if-unchanged: " << path << " changed";
+      upToDate = false;
+    }
+  }
+
+  SmallVector<bool, 0> changed(oldInputs.size());
+  parallelFor(0, oldInputs.size(), [&](size_t i) {
+    auto [hashStr, path] = oldInputs[i];
+    uint64_t hash;
+    auto it = loaded.find(path);
+    if (it != loaded.end()) {
+      hash = it->second;
+    } else {
+      ErrorOr<std::unique_ptr<MemoryBuffer>> inputOrErr =
+          MemoryBuffer::getFile(path, /*IsText=*/false,
+                                /*RequiresNullTerminator=*/false);
+      if (!inputOrErr) {
+        changed[i] = true;
+        return;
+      }
+      hash = xxh3_64bits((*inputOrErr)->getBuffer());
+    }
+    changed[i] = hashStr != utostr(hash);
+  });
+  for (auto [input, isChanged] : llvm::zip_equal(oldInputs, changed)) {
+    if (isChanged) {
+      Log(ctx) << "skip-if-unchanged: " << input.second << " changed";
+      upToDate = false;
+    }
+  }
+  if (!upToDate || !canSkipLink(ctx, args))
+    return false;
+
+  std::optional<std::string> stamp = getFileStamp(ctx.arg.outputFile);
+  return stamp && "output " + *stamp == oldStamp;
+}
+
+// Write the state for a successful link. inputHashes and inputStamps describe
+// the files loaded before the link started and were computed at that time;
+// files loaded during the link are hashed now. If an input's size or
+// modification time changed while linking, the recorded hash may not match
+// what the link read, so no state is written and the next link is a full one.
+static void writeSkipState(Ctx &ctx, const opt::InputArgList &args,
+                           SmallVectorImpl<uint64_t> &inputHashes,
+                           ArrayRef<std::optional<std::string>> inputStamps) {
+  std::string statePath = getSkipStatePath(ctx);
+  sys::fs::remove(statePath);
+
+  SmallVector<std::optional<std::string>, 0> stamps;
+  getInputStamps(ctx, stamps);
+  for (auto [mb, before, after] :
+       llvm::zip(ctx.memoryBuffers, inputStamps, stamps)) {
+    if (!before || before != after) {
+      Log(ctx) << "skip-if-unchanged: " << mb->getBufferIdentifier()
+               << " was modified during the link";
+      return;
+    }
+  }
+  hashInputs(ctx, inputHashes.size(), inputHashes);
+
+  std::optional<std::string> stamp = getFileStamp(ctx.arg.outputFile);
+  if (!stamp)
+    return;
+  std::error_code ec;
+  raw_fd_ostream os(statePath, ec, sys::fs::OF_None);
+  if (ec) {
+    Warn(ctx) << "cannot write " << statePath << ": " << ec.message();
+    return;
+  }
+  os << getSkipStateHeader(args);
+  for (auto [mb, hash] : llvm::zip_equal(ctx.memoryBuffers, inputHashes))
+    os << "input " << hash << " " << mb->getBufferIdentifier() << "\n";
+  os << "output " << *stamp << "\n";
+}
+
 void LinkerDriver::linkerMain(ArrayRef<const char *> argsArr) {
   ELFOptTable parser;
   opt::InputArgList args = parser.parse(ctx, argsArr.slice(1));
@@ -720,13 +915,32 @@ void LinkerDriver::linkerMain(ArrayRef<const char *> argsArr) {
     if (errCount(ctx))
       return;
 
-    inferMachineType();
-    setConfigs(ctx, args);
-    checkOptions(ctx);
-    if (errCount(ctx))
-      return;
+    // Hash the inputs before linking, so that the recorded state describes
+    // what this link read even if an input is edited while it runs.
+    SmallVector<uint64_t, 0> inputHashes;
+    SmallVector<std::optional<std::string>, 0> inputStamps;
+    bool upToDate = false;
+    if (ctx.arg.skipIfUnchanged) {
+      getInputStamps(ctx, inputStamps);
+      hashInputs(ctx, 0, inputHashes);
+      upToDate = isOutputUpToDate(ctx, args, inputHashes);
+      if (upToDate)
+        Log(ctx) << "skip-if-unchanged: " << ctx.arg.outputFile
+                 << " is up to date";
+    }
 
-    invokeELFT(link, args);
+    if (!upToDate) {
+      inferMachineType();
+      setConfigs(ctx, args);
+      checkOptions(ctx);
+      if (errCount(ctx))
+        return;
+
+      invokeELFT(link, args);
+
+      if (ctx.arg.skipIfUnchanged && !errCount(ctx))
+        writeSkipState(ctx, args, inputHashes, inputStamps);
+    }
   }
 
   if (ctx.arg.timeTraceEnabled) {
@@ -1518,6 +1732,8 @@ static void readConfigs(Ctx &ctx, opt::InputArgList &args) {
   ctx.arg.rejectMismatch = !args.hasArg(OPT_no_warn_mismatch);
   ctx.arg.relax = args.hasFlag(OPT_relax, OPT_no_relax, true);
   ctx.arg.relaxGP = args.hasFlag(OPT_relax_gp, OPT_no_relax_gp, false);
+  ctx.arg.releaseInputPages =
+      args.hasFlag(OPT_release_input_pages, OPT_no_release_input_pages, false);
   ctx.arg.rpath = getRpath(args);
   ctx.arg.relocatable = args.hasArg(OPT_relocatable);
   ctx.arg.resolveGroups =
@@ -1544,6 +1760,8 @@ static void readConfigs(Ctx &ctx, opt::InputArgList &args) {
         args::getInteger(args, OPT_randomize_section_padding, 0);
   ctx.arg.singleRoRx = !args.hasFlag(OPT_rosegment, OPT_no_rosegment, true);
   ctx.arg.singleXoRx = !args.hasFlag(OPT_xosegment, OPT_no_xosegment, false);
+  ctx.arg.skipIfUnchanged =
+      args.hasFlag(OPT_skip_if_unchanged, OPT_no_skip_if_unchanged, false);
   ctx.arg.soName = args.getLastArgValue(OPT_soname);
   ctx.arg.sortSection = getSortSection(ctx, args);
   ctx.arg.splitStackAdjustSize =
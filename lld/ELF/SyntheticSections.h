@@ -1099,6 +1099,10 @@ public:
   void addSection(MergeInputSection *ms);
   SmallVector<MergeInputSection *, 0> sections;
 
+  static bool classof(const SectionBase *d) {
+    return SyntheticSection::classof(d) && (d->flags & llvm::ELF::SHF_MERGE);
+  }
+
 protected:
   MergeSyntheticSection(Ctx &ctx, StringRef name, uint32_t type, uint64_t flags,
                         uint32_t addralign)
@@ -79,6 +79,7 @@ private:
   void writeTrapInstr();
   void writeHeader();
   void writeSections();
+  void writeSectionsReleasingInputs(ArrayRef<OutputSection *> secs);
   void writeSectionsBinary();
   void writeBuildId();
 
@@ -3004,7 +3005,13 @@ template <class ELFT> void Writer<ELFT>::writeSections() {
       if (isStaticRelSecType(sec->type))
         sec->writeTo<ELFT>(ctx, ctx.bufferStart + sec->offset, tg);
   }
-  {
+  if (ctx.arg.releaseInputPages) {
+    SmallVector<OutputSection *, 0> secs;
+    for (OutputSection *sec : ctx.outputSections)
+      if (!isStaticRelSecType(sec->type))
+        secs.push_back(sec);
+    writeSectionsReleasingInputs(secs);
+  } else {
     parallel::TaskGroup tg;
     for (OutputSection *sec : ctx.outputSections)
       if (!isStaticRelSecType(sec->type))
@@ -3019,6 +3026,102 @@ template <class ELFT> void Writer<ELFT>::writeSections() {
   }
 }
 
+// With --release-input-pages, write output sections in file offset order, in
+// batches of roughly batchSize bytes, and mark memory-mapped input files as
+// MADV_DONTNEED as soon as all output sections containing their sections have
+// been written. This bounds the resident input pages by the working set of a
+// batch rather than by the total input size. Pages that are accessed again
+// later (e.g. symbol names) are transparently faulted in from the file.
+template <class ELFT>
+void Writer<ELFT>::writeSectionsReleasingInputs(ArrayRef<OutputSection *> in) {
+  if (in.empty())
+    return;
+  SmallVector<OutputSection *, 0> secs(in);
+  llvm::stable_sort(secs, [](const OutputSection *a, const OutputSection *b) {
+    return a->offset < b->offset;
+  });
+
+  // Sorted start addresses of the memory-mapped input buffers, used to find
+  // the buffer backing an input file (archive members live inside the
+  // archive's buffer).
+  SmallVector<std::pair<const char *, size_t>, 0> bufs;
+  for (auto [i, mb] : llvm::enumerate(ctx.memoryBuffers))
+    if (mb->getBufferKind() == MemoryBuffer::MemoryBuffer_MMap)
+      bufs.emplace_back(mb->getBufferStart(), i);
+  llvm::sort(bufs, llvm::less_first());
+  auto findBuffer = [&](const InputFile *file) -> std::optional<size_t> {
+    const char *p = file->mb.getBufferStart();
+    auto it = llvm::upper_bound(
+        bufs, p, [](const char *p, const std::pair<const char *, size_t> &e) {
+          return p < e.first;
+        });
+    if (it == bufs.begin())
+      return std::nullopt;
+    --it;
+    if (p >= ctx.memoryBuffers[it->second]->getBufferEnd())
+      return std::nullopt;
+    return it->second;
+  };
+
+  // For each buffer, compute the index of the last output section in secs
+  // that reads from it. Merge, .eh_frame and .ARM.exidx synthetic sections
+  // read from the input sections they were built from. Buffers without a
+  // known last use, e.g. those only read for symbol names, are not released.
+  const size_t unknownUse = std::numeric_limits<size_t>::max();
+  SmallVector<size_t, 0> lastUse(ctx.memoryBuffers.size(), unknownUse);
+  DenseMap<const InputFile *, std::optional<size_t>> fileToBuffer;
+  auto recordUse = [&](const InputSectionBase *isec, size_t i) {
+    if (!isec->file)
+      return;
+    auto [it, inserted] = fileToBuffer.try_emplace(isec->file);
+    if (inserted)
+      it->second = findBuffer(isec->file);
+    if (it->second)
+      lastUse[*it->second] = i;
+  };
+  SmallVector<InputSection *, 0> storage;
+  for (auto [i, sec] : llvm::enumerate(secs)) {
+    for (InputSection *isec : getInputSections(*sec, storage)) {
+      if (auto *ms = dyn_cast<MergeSyntheticSection>(isec))
+        for (MergeInputSection *s : ms->sections)
+          recordUse(s, i);
+      else if (auto *eh = dyn_cast<EhFrameSection>(isec))
+        for (EhInputSection *s : eh->sections)
+          recordUse(s, i);
+      else if (auto *exidx = dyn_cast<ARMExidxSyntheticSection>(isec))
+        for (InputSection *s : exidx->exidxSections)
+          recordUse(s, i);
+      else
+        recordUse(isec, i);
+    }
+  }
+  SmallVector<SmallVector<size_t, 0>, 0> releaseAfter(secs.size());
+  for (const std::pair<const char *, size_t> &e : bufs)
+    if (lastUse[e.second] != unknownUse)
+      releaseAfter[lastUse[e.second]].push_back(e.second);
+
+  const uint64_t batchSize = 64 << 20;
+  for (size_t begin = 0, end; begin != secs.size(); begin = end) {
+    uint64_t size = 0;
+    end = begin;
+    {
+      parallel::TaskGroup tg;
+      do {
+        secs[end]->writeTo<ELFT>(ctx, ctx.bufferStart + secs[end]->offset, tg);
+        size += secs[end]->size;
+      } while (++end != secs.size() && size < batchSize);
+    }
+    for (size_t i = begin; i != end; ++i) {
+      for (size_t idx : releaseAfter[i]) {
+        Log(ctx) << "release-input-pages: releasing "
+                 << ctx.memoryBuffers[idx]->getBufferIdentifier() << " after "
+                 << secs[i]->name;
+        ctx.memoryBuffers[idx]->dontNeedIfMmap();
+      }
+    }
+  }
+}
+
 // Computes a hash value of Data using a given hash function.
 // In order to utilize multiple cores, we first split data into 1MB
 // chunks, compute a hash for each chunk, and then compute a hash value
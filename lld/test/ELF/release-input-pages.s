@@ -0,0 +1,64 @@
+# REQUIRES: x86
+## --release-input-pages releases an input file after the last output section
+## that reads from it, including sections that are only written through merge
+## and .eh_frame synthetic sections. Files without a known last use are kept.
+## The unused .space sections make the inputs large enough to be mmap'ed.
+
+# RUN: rm -rf %t && split-file %s %t && cd %t
+# RUN: llvm-mc -filetype=obj -triple=x86_64 a.s -o a.o
+# RUN: llvm-mc -filetype=obj -triple=x86_64 b.s -o b.o
+# RUN: llvm-mc -filetype=obj -triple=x86_64 c.s -o c.o
+# RUN: ld.lld -T lds --gc-sections --release-input-pages a.o b.o c.o -o out \
+# RUN:   --verbose 2>&1 | FileCheck %s
+# RUN: ld.lld -T lds --gc-sections a.o b.o c.o -o ref
+# RUN: cmp out ref
+
+# CHECK-NOT: releasing c.o
+# CHECK-DAG: release-input-pages: releasing b.o after .rodata
+# CHECK-DAG: release-input-pages: releasing a.o after .eh_frame
+# CHECK-NOT: releasing c.o
+
+#--- lds
+SECTIONS {
+  .text : { *(.text*) }
+  .rodata : { *(.rodata*) }
+  .eh_frame : { *(.eh_frame) }
+}
+
+#--- a.s
+.globl foo
+.section .text.foo,"ax",@progbits
+foo:
+  .cfi_startproc
+  leaq .Lstr(%rip), %rax
+  ret
+  .cfi_endproc
+
+.section .rodata.str1.1,"aMS",@progbits,1
+.Lstr:
+.asciz "a"
+
+.section .text.unused_a,"ax",@progbits
+.space 20000
+
+#--- b.s
+.globl _start
+.section .text._start,"ax",@progbits
+_start:
+  call foo
+  leaq .Lstr(%rip), %rax
+  movl $abs, %eax
+
+.section .rodata.str1.1,"aMS",@progbits,1
+.Lstr:
+.asciz "b"
+
+.section .text.unused_b,"ax",@progbits
+.space 20000
+
+#--- c.s
+.globl abs
+abs = 42
+
+.section .text.unused_c,"ax",@progbits
+.space 20000
@@ -0,0 +1,84 @@
+# REQUIRES: x86
+## Test --skip-if-unchanged: the link is skipped only if the options, every
+## input and the output are unchanged since the previous link.
+
+# RUN: rm -rf %t && split-file %s %t && cd %t
+# RUN: llvm-mc -filetype=obj -triple=x86_64 a.s -o a.o
+# RUN: llvm-mc -filetype=obj -triple=x86_64 b.s -o b.o
+# RUN: llvm-mc -filetype=obj -triple=x86_64 b2.s -o b2.o
+# RUN: cp b.o lib.o
+
+## The first link writes the state file.
+# RUN: ld.lld --skip-if-unchanged a.o lib.o -o out --verbose 2>&1 | \
+# RUN:   FileCheck %s --check-prefix=LINK
+# RUN: ls out.lld-skip-state
+# LINK-NOT: is up to date
+
+## Nothing changed, so the link is skipped.
+# RUN: ld.lld --skip-if-unchanged a.o lib.o -o out --verbose 2>&1 | \
+# RUN:   FileCheck %s --check-prefix=SKIP
+# SKIP: skip-if-unchanged: out is up to date
+
+## Touching an input without changing its contents is detected by rehashing
+## it, and the link is still skipped.
+# RUN: touch lib.o
+# RUN: ld.lld --skip-if-unchanged a.o lib.o -o out --verbose 2>&1 | \
+# RUN:   FileCheck %s --check-prefix=SKIP
+
+## Changed contents force a link.
+# RUN: cp b2.o lib.o
+# RUN: ld.lld --skip-if-unchanged a.o lib.o -o out --verbose 2>&1 | \
+# RUN:   FileCheck %s --check-prefix=CHANGED
+# CHANGED: skip-if-unchanged: lib.o changed
+# CHANGED-NOT: is up to date
+# RUN: ld.lld --skip-if-unchanged a.o lib.o -o out --verbose 2>&1 | \
+# RUN:   FileCheck %s --check-prefix=SKIP
+
+## Different options force a link.
+# RUN: ld.lld --skip-if-unchanged a.o lib.o -o out --gc-sections --verbose 2>&1 | \
+# RUN:   FileCheck %s --check-prefix=OPTIONS
+# OPTIONS: skip-if-unchanged: options or linker version changed
+
+## A modified or missing output is regenerated.
+# RUN: ld.lld --skip-if-unchanged a.o lib.o -o out --verbose 2>&1 | \
+# RUN:   FileCheck %s --check-prefix=LINK
+# RUN: echo garbage > out
+# RUN: ld.lld --skip-if-unchanged a.o lib.o -o out --verbose 2>&1 | \
+# RUN:   FileCheck %s --check-prefix=LINK
+# RUN: rm out
+# RUN: ld.lld --skip-if-unchanged a.o lib.o -o out --verbose 2>&1 | \
+# RUN:   FileCheck %s --check-prefix=LINK
+# RUN: ls out
+
+## Reports written by every link force a link.
+# RUN: ld.lld --skip-if-unchanged a.o lib.o -o out -Map=out.map
+# RUN: rm out.map
+# RUN: ld.lld --skip-if-unchanged a.o lib.o -o out -Map=out.map --verbose 2>&1 | \
+# RUN:   FileCheck %s --check-prefix=LINK
+# RUN: ls out.map
+
+## A skipped link still writes the --time-trace output.
+# RUN: ld.lld --skip-if-unchanged a.o lib.o -o out --time-trace=out.json
+# RUN: rm out.json
+# RUN: ld.lld --skip-if-unchanged a.o lib.o -o out --time-trace=out.json --verbose 2>&1 | \
+# RUN:   FileCheck %s --check-prefix=SKIP
+# RUN: ls out.json
+
+## Without the option, the link always runs.
+# RUN: ld.lld a.o lib.o -o out --verbose 2>&1 | FileCheck %s --check-prefix=LINK
+
+#--- a.s
+.globl _start
+_start:
+  call foo
+
+#--- b.s
+.globl foo
+foo:
+  ret
+
+#--- b2.s
+.globl foo
+foo:
+  nop
+  ret
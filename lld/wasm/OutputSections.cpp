@@ -16,6 +16,7 @@
 #include "lld/Common/Memory.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/Support/LEB128.h"
+#include "llvm/Support/Parallel.h"
 
 #define DEBUG_TYPE "lld"
 
@@ -76,9 +77,11 @@ void CodeSection::writeTo(uint8_t *buf) {
   // Write code section headers
   memcpy(buf, codeSectionHeader.data(), codeSectionHeader.size());
 
-  // Write code section bodies
-  for (const InputChunk *chunk : functions)
-    chunk->writeTo(buf);
+  // Write code section bodies. Every function has its final offset by now and
+  // only writes its own range, so they can be written (and relocated) in
+  // parallel.
+  parallelForEach(functions,
+                  [&](const InputChunk *chunk) { chunk->writeTo(buf); });
 }
 
 uint32_t CodeSection::getNumRelocations() const {
@@ -172,9 +175,9 @@ void DataSection::writeTo(uint8_t *buf) {
   // Write data section headers
   memcpy(buf, dataSectionHeader.data(), dataSectionHeader.size());
 
-  for (const OutputSegment *segment : segments) {
+  parallelForEach(segments, [&](const OutputSegment *segment) {
     if (!segment->requiredInBinary())
-      continue;
+      return;
     // Write data segment header
     uint8_t *segStart = buf + segment->sectionOffset;
     memcpy(segStart, segment->header.data(), segment->header.size());
@@ -182,7 +185,7 @@ void DataSection::writeTo(uint8_t *buf) {
     // Write segment data payload
     for (const InputChunk *chunk : segment->inputSegments)
       chunk->writeTo(buf);
-  }
+  });
 }
 
 uint32_t DataSection::getNumRelocations() const {
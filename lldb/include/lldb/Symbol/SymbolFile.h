@@ -422,6 +422,13 @@ public:
   /// hasn't been indexed yet, or a valid duration if it has.
   virtual StatsDuration::Duration GetDebugInfoIndexTime() { return {}; }
 
+  /// Return the time spent completing forward declared types from the debug
+  /// information.
+  ///
+  /// \returns 0.0 if no types have been completed or if this symbol file
+  /// doesn't complete types lazily.
+  virtual StatsDuration::Duration GetTypeCompletionTime() { return {}; }
+
   /// Reset the statistics for the symbol file.
   virtual void ResetStatistics() {}
 
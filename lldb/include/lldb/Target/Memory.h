@@ -63,6 +63,12 @@ private:
   const MemoryCache &operator=(const MemoryCache &) = delete;
 
   lldb::DataBufferSP GetL2CacheLine(lldb::addr_t addr, Status &error);
+
+  /// Fill \a num_lines consecutive, currently uncached L2 cache lines
+  /// starting at \a line_base_addr with a single read from the inferior.
+  /// Returns false if nothing could be read, in which case the caller should
+  /// fall back to reading the lines one at a time.
+  bool FillL2CacheLines(lldb::addr_t line_base_addr, uint32_t num_lines);
 };
 
     
@@ -120,6 +120,8 @@ public:
 
   bool GetParallelModuleLoad() const;
 
+  bool GetParallelThreadUnwind() const;
+
   const char *GetDisassemblyFlavor() const;
 
   const char *GetDisassemblyCPU() const;
@@ -132,6 +132,13 @@ public:
 
   void DiscardThreadPlans();
 
+  /// Unwind the first \a num_frames frames of each thread in \a tids on the
+  /// debugger's thread pool, so that a following serial walk over the
+  /// threads finds their frames already computed. Threads that are no longer
+  /// in the list are ignored.
+  void PrefetchStackFrames(llvm::ArrayRef<lldb::tid_t> tids,
+                           uint32_t num_frames);
+
   uint32_t GetStopID() const;
 
   void SetStopID(uint32_t stop_id);
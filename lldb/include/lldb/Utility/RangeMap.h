@@ -475,6 +475,8 @@ public:
   /// \param T The data associated with the memory range
   void Append(B &&b, S &&s, T &&t) { m_entries.emplace_back(Entry(b, s, t)); }
 
+  void Reserve(typename Collection::size_type size) { m_entries.reserve(size); }
+
   bool Erase(uint32_t start, uint32_t end) {
     if (start >= end || end > m_entries.size())
       return false;
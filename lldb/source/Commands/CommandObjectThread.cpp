@@ -38,6 +38,8 @@
 #include "lldb/Utility/State.h"
 #include "lldb/ValueObject/ValueObject.h"
 
+#include "llvm/Support/MathExtras.h"
+
 using namespace lldb;
 using namespace lldb_private;
 
@@ -254,6 +256,12 @@ protected:
     return true;
   }
 
+  uint32_t GetNumFramesToPrefetch() override {
+    if (m_options.m_count == UINT32_MAX)
+      return UINT32_MAX;
+    return llvm::SaturatingAdd(m_options.m_start, m_options.m_count);
+  }
+
   CommandOptions m_options;
 };
 
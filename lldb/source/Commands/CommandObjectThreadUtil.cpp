@@ -10,6 +10,7 @@
 
 #include "lldb/Interpreter/CommandReturnObject.h"
 #include "lldb/Target/Process.h"
+#include "lldb/Target/Target.h"
 #include "lldb/Target/Thread.h"
 
 using namespace lldb;
@@ -87,6 +88,16 @@ void CommandObjectIterateOverThreads::DoExecute(Args &command,
     }
   }
 
+  if (uint32_t num_frames = GetNumFramesToPrefetch()) {
+    Process *process = m_exe_ctx.GetProcessPtr();
+    if (process->GetTarget().GetParallelThreadUnwind()) {
+      // Bucketing unique stacks compares whole call stacks.
+      if (m_unique_stacks)
+        num_frames = UINT32_MAX;
+      process->GetThreadList().PrefetchStackFrames(tids, num_frames);
+    }
+  }
+
   if (m_unique_stacks) {
     // Iterate over threads, finding unique stack buckets.
     std::set<UniqueStack> unique_stacks;
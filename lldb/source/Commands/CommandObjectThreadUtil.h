@@ -69,6 +69,12 @@ protected:
 
   virtual bool HandleOneThread(lldb::tid_t, CommandReturnObject &result) = 0;
 
+  // Override this to return how many frames of each thread HandleOneThread
+  // will look at. When the target's parallel-thread-unwind setting is on,
+  // that many frames are unwound for all threads in parallel up front.
+  // Returning 0 disables the prefetch.
+  virtual uint32_t GetNumFramesToPrefetch() { return 0; }
+
   bool BucketThread(lldb::tid_t tid, std::set<UniqueStack> &unique_stacks,
                     CommandReturnObject &result);
 
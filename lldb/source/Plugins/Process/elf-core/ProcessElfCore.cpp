@@ -191,6 +191,15 @@ Status ProcessElfCore::DoLoadCore() {
 
   m_thread_data_valid = true;
 
+  // Large cores can have tens of thousands of PT_LOAD segments, size the
+  // address maps once instead of growing them segment by segment.
+  const size_t num_load_segments =
+      llvm::count_if(segments, [](const elf::ELFProgramHeader &H) {
+        return H.p_type == llvm::ELF::PT_LOAD;
+      });
+  m_core_aranges.Reserve(num_load_segments);
+  m_core_range_infos.Reserve(num_load_segments);
+
   bool ranges_are_sorted = true;
   lldb::addr_t vm_addr = 0;
   lldb::addr_t tag_addr = 0;
@@ -200,10 +209,10 @@ Status ProcessElfCore::DoLoadCore() {
   /// PT_AARCH64_MEMTAG_MTE - Contains AArch64 MTE memory tags for a range of
   ///                         Process Address Space.
   for (const elf::ELFProgramHeader &H : segments) {
-    DataExtractor data = core->GetSegmentData(H);
-
-    // Parse thread contexts and auxv structure
+    // Parse thread contexts and auxv structure. Only notes need their
+    // contents here, the memory segments are read on demand by DoReadMemory.
     if (H.p_type == llvm::ELF::PT_NOTE) {
+      DataExtractor data = core->GetSegmentData(H);
       if (llvm::Error error = ParseThreadContextsFromNoteSegment(H, data))
         return Status::FromError(std::move(error));
     }
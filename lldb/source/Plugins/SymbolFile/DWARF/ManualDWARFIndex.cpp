@@ -135,8 +135,15 @@ void ManualDWARFIndex::Index() {
   for (NameToDIE IndexSet<NameToDIE>::*index : indices) {
     task_group.async([this, &sets, index, &progress]() {
       NameToDIE &result = m_set.*index;
+      size_t total = result.GetSize();
       for (auto &set : sets)
+        total += (set.*index).GetSize();
+      result.Reserve(total);
+      for (auto &set : sets) {
         result.Append(set.*index);
+        // Release the partial index as soon as it has been merged.
+        set.*index = NameToDIE();
+      }
       result.Finalize();
       progress.Increment();
     });
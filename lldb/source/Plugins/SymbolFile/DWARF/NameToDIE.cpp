@@ -102,13 +102,23 @@ bool NameToDIE::Decode(const DataExtractor &data, lldb::offset_t *offset_ptr,
     return false;
   const uint32_t count = data.GetU32(offset_ptr);
   m_map.Reserve(count);
+  // Entries were encoded in name order, so all DIEs for a name are adjacent
+  // and share a string table offset. Only create a ConstString, which hashes
+  // and locks a string pool, when the name changes.
+  uint32_t prev_strtab_offset = UINT32_MAX;
+  ConstString name;
   for (uint32_t i = 0; i < count; ++i) {
-    llvm::StringRef str(strtab.Get(data.GetU32(offset_ptr)));
-    // No empty strings allowed in the name to DIE maps.
-    if (str.empty())
-      return false;
+    const uint32_t strtab_offset = data.GetU32(offset_ptr);
+    if (strtab_offset != prev_strtab_offset) {
+      llvm::StringRef str(strtab.Get(strtab_offset));
+      // No empty strings allowed in the name to DIE maps.
+      if (str.empty())
+        return false;
+      name = ConstString(str);
+      prev_strtab_offset = strtab_offset;
+    }
     if (std::optional<DIERef> die_ref = DIERef::Decode(data, offset_ptr))
-      m_map.Append(ConstString(str), *die_ref);
+      m_map.Append(name, *die_ref);
     else
       return false;
   }
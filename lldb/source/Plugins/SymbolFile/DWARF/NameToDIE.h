@@ -32,6 +32,12 @@ public:
 
   void Append(const NameToDIE &other);
 
+  /// Reserve space for \a n entries, so that appending them doesn't
+  /// reallocate and Finalize() doesn't need to shrink the storage.
+  void Reserve(size_t n) { m_map.Reserve(n); }
+
+  size_t GetSize() const { return m_map.GetSize(); }
+
   void Finalize();
 
   bool Find(ConstString name,
@@ -8,6 +8,7 @@
 
 #include "SymbolFileDWARF.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/ScopeExit.h"
 #include "llvm/DebugInfo/DWARF/DWARFAddressRange.h"
 #include "llvm/DebugInfo/DWARF/DWARFDebugLoc.h"
 #include "llvm/Support/Casting.h"
@@ -1580,6 +1581,14 @@ bool SymbolFileDWARF::CompleteType(CompilerType &compiler_type) {
   // declaration map in case anyone's child members or other types require this
   // type to get resolved.
   GetForwardDeclCompilerTypeToDIE().erase(die_it);
+
+  std::optional<ElapsedTime> elapsed;
+  if (m_type_completion_depth == 0)
+    elapsed.emplace(m_type_completion_time);
+  ++m_type_completion_depth;
+  auto depth_guard =
+      llvm::make_scope_exit([this] { --m_type_completion_depth; });
+
   DWARFDIE def_die = FindDefinitionDIE(decl_die);
   if (!def_die) {
     SymbolFileDWARFDebugMap *debug_map_symfile = GetDebugMapSymfile();
@@ -4359,6 +4368,7 @@ StatsDuration::Duration SymbolFileDWARF::GetDebugInfoIndexTime() {
 
 void SymbolFileDWARF::ResetStatistics() {
   m_parse_time.reset();
+  m_type_completion_time.reset();
   if (m_index)
     return m_index->ResetStatistics();
 }
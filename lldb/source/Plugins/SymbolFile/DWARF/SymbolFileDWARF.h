@@ -316,6 +316,10 @@ public:
   }
   StatsDuration::Duration GetDebugInfoIndexTime() override;
 
+  StatsDuration::Duration GetTypeCompletionTime() override {
+    return m_type_completion_time;
+  }
+
   StatsDuration &GetDebugInfoParseTimeRef() { return m_parse_time; }
 
   void ResetStatistics() override;
@@ -549,6 +553,11 @@ protected:
   /// address in the module.
   lldb::addr_t m_first_code_address = LLDB_INVALID_ADDRESS;
   StatsDuration m_parse_time;
+  /// Time spent in CompleteType(). Only the outermost completion is timed so
+  /// that member and base class types completed along the way are not
+  /// counted twice; m_type_completion_depth tracks the nesting.
+  StatsDuration m_type_completion_time;
+  uint32_t m_type_completion_depth = 0;
   std::atomic_flag m_dwo_warning_issued = ATOMIC_FLAG_INIT;
   /// If this DWARF file a .DWO file or a DWARF .o file on mac when
   /// no dSYM file is being used, this file index will be set to a
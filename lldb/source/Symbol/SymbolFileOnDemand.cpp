@@ -556,6 +556,13 @@ StatsDuration::Duration SymbolFileOnDemand::GetDebugInfoIndexTime() {
   return m_sym_file_impl->GetDebugInfoIndexTime();
 }
 
+StatsDuration::Duration SymbolFileOnDemand::GetTypeCompletionTime() {
+  // Always return the real type completion time.
+  LLDB_LOG(GetLog(), "[{0}] {1} is not skipped", GetSymbolFileName(),
+           __FUNCTION__);
+  return m_sym_file_impl->GetTypeCompletionTime();
+}
+
 void SymbolFileOnDemand::ResetStatistics() {
   LLDB_LOG(GetLog(), "[{0}] {1} is not skipped", GetSymbolFileName(),
            __FUNCTION__);
@@ -14,6 +14,7 @@
 #include "lldb/Utility/RangeMap.h"
 #include "lldb/Utility/State.h"
 
+#include <algorithm>
 #include <cinttypes>
 #include <memory>
 
@@ -151,6 +152,32 @@ lldb::DataBufferSP MemoryCache::GetL2CacheLine(lldb::addr_t line_base_addr,
   return data_buffer_heap_sp;
 }
 
+bool MemoryCache::FillL2CacheLines(lldb::addr_t line_base_addr,
+                                   uint32_t num_lines) {
+  assert((line_base_addr % m_L2_cache_line_byte_size) == 0);
+
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  const size_t total_size = (size_t)m_L2_cache_line_byte_size * num_lines;
+  DataBufferHeap buffer(total_size, 0);
+  Status error;
+  size_t bytes_read = m_process.ReadMemoryFromInferior(
+      line_base_addr, buffer.GetBytes(), total_size, error);
+  if (bytes_read == 0)
+    return false;
+
+  // Split what we got into individual cache lines. A short read leaves the
+  // last line partially filled and the remaining lines uncached, exactly as
+  // if they had been read one by one.
+  for (size_t offset = 0; offset < bytes_read;
+       offset += m_L2_cache_line_byte_size) {
+    size_t line_size = std::min<size_t>(m_L2_cache_line_byte_size,
+                                        bytes_read - offset);
+    m_L2_cache[line_base_addr + offset] = std::make_shared<DataBufferHeap>(
+        buffer.GetBytes() + offset, line_size);
+  }
+  return true;
+}
+
 size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len,
                          Status &error) {
   if (!dst || dst_len == 0)
@@ -206,6 +233,19 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len,
   // We're going to have all of our loads and reads be cache line aligned.
   addr_t cache_line_offset = addr % m_L2_cache_line_byte_size;
   addr_t cache_line_base_addr = addr - cache_line_offset;
+
+  // If the read straddles two lines and neither is cached yet, fetch both
+  // with one request instead of paying for two round trips to the inferior.
+  // This matters most for remote targets where each read is a packet.
+  if (cache_line_offset + dst_len > m_L2_cache_line_byte_size) {
+    addr_t second_line_addr = cache_line_base_addr + m_L2_cache_line_byte_size;
+    if (second_line_addr > cache_line_base_addr &&
+        !m_L2_cache.count(cache_line_base_addr) &&
+        !m_L2_cache.count(second_line_addr) &&
+        !m_invalid_ranges.FindEntryThatContains(second_line_addr))
+      FillL2CacheLines(cache_line_base_addr, 2);
+  }
+
   DataBufferSP first_cache_line = GetL2CacheLine(cache_line_base_addr, error);
   // If we get nothing, then the read to the inferior likely failed. Nothing to
   // do here.
@@ -61,6 +61,7 @@ json::Value ModuleStats::ToJSON() const {
   module.try_emplace("symbolTableSavedToCache", symtab_saved_to_cache);
   module.try_emplace("debugInfoParseTime", debug_parse_time);
   module.try_emplace("debugInfoIndexTime", debug_index_time);
+  module.try_emplace("typeCompletionTime", type_completion_time);
   module.try_emplace("debugInfoByteSize", (int64_t)debug_info_size);
   module.try_emplace("debugInfoIndexLoadedFromCache",
                      debug_info_index_loaded_from_cache);
@@ -306,6 +307,7 @@ llvm::json::Value DebuggerStats::ReportStatistics(
   double symtab_index_time = 0.0;
   double debug_parse_time = 0.0;
   double debug_index_time = 0.0;
+  double type_completion_time = 0.0;
   uint32_t symtabs_loaded = 0;
   uint32_t symtabs_loaded_from_cache = 0;
   uint32_t symtabs_saved_to_cache = 0;
@@ -371,6 +373,8 @@ llvm::json::Value DebuggerStats::ReportStatistics(
         ++debug_index_saved;
       module_stat.debug_index_time = sym_file->GetDebugInfoIndexTime().count();
       module_stat.debug_parse_time = sym_file->GetDebugInfoParseTime().count();
+      module_stat.type_completion_time =
+          sym_file->GetTypeCompletionTime().count();
       module_stat.debug_info_size =
           sym_file->GetDebugInfoSize(load_all_debug_info);
       module_stat.symtab_stripped = module->GetObjectFile()->IsStripped();
@@ -391,6 +395,7 @@ llvm::json::Value DebuggerStats::ReportStatistics(
     symtab_index_time += module_stat.symtab_index_time;
     debug_parse_time += module_stat.debug_parse_time;
     debug_index_time += module_stat.debug_index_time;
+    type_completion_time += module_stat.type_completion_time;
     debug_info_size += module_stat.debug_info_size;
     module->ForEachTypeSystem([&](lldb::TypeSystemSP ts) {
       if (auto stats = ts->ReportStatistics())
@@ -424,6 +429,7 @@ llvm::json::Value DebuggerStats::ReportStatistics(
       {"totalSymbolTablesSavedToCache", symtabs_saved_to_cache},
       {"totalDebugInfoParseTime", debug_parse_time},
       {"totalDebugInfoIndexTime", debug_index_time},
+      {"totalTypeCompletionTime", type_completion_time},
       {"totalDebugInfoIndexLoadedFromCache", debug_index_loaded},
       {"totalDebugInfoIndexSavedToCache", debug_index_saved},
       {"totalDebugInfoByteSize", debug_info_size},
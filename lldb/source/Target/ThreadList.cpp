@@ -10,6 +10,7 @@
 
 #include <algorithm>
 
+#include "lldb/Core/Debugger.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Target/RegisterContext.h"
 #include "lldb/Target/Thread.h"
@@ -20,6 +21,8 @@
 #include "lldb/Utility/Log.h"
 #include "lldb/Utility/State.h"
 
+#include "llvm/Support/ThreadPool.h"
+
 using namespace lldb;
 using namespace lldb_private;
 
@@ -684,6 +687,31 @@ void ThreadList::DidStop() {
   }
 }
 
+void ThreadList::PrefetchStackFrames(llvm::ArrayRef<lldb::tid_t> tids,
+                                     uint32_t num_frames) {
+  if (num_frames == 0 || tids.size() < 2)
+    return;
+
+  std::vector<ThreadSP> threads;
+  {
+    std::lock_guard<std::recursive_mutex> guard(GetMutex());
+    threads.reserve(tids.size());
+    for (lldb::tid_t tid : tids)
+      if (ThreadSP thread_sp = FindThreadByID(tid, /*can_update=*/false))
+        threads.push_back(std::move(thread_sp));
+  }
+
+  // Each thread's frame list and unwinder are guarded by that thread's own
+  // mutex, and memory reads go through the process memory cache, so the
+  // threads can be unwound independently.
+  llvm::ThreadPoolTaskGroup task_group(Debugger::GetThreadPool());
+  for (const ThreadSP &thread_sp : threads)
+    task_group.async([thread_sp, num_frames] {
+      thread_sp->GetStackFrameAtIndex(num_frames - 1);
+    });
+  task_group.wait();
+}
+
 ThreadSP ThreadList::GetSelectedThread() {
   std::lock_guard<std::recursive_mutex> guard(GetMutex());
   ThreadSP thread_sp = FindThreadByID(m_selected_tid);
@@ -8,6 +8,8 @@
 
 #include "lldb/Target/Thread.h"
 #include "Plugins/Platform/Linux/PlatformLinux.h"
+#include "TestingSupport/TestUtilities.h"
+#include <atomic>
 #include <thread>
 #ifdef _WIN32
 #include "lldb/Host/windows/HostThreadWindows.h"
@@ -24,6 +26,7 @@
 #include "lldb/Host/HostThread.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Target/StopInfo.h"
+#include "lldb/Target/ThreadList.h"
 #include "lldb/Utility/ArchSpec.h"
 #include "gtest/gtest.h"
 
@@ -53,6 +56,8 @@ public:
     PlatformWindows::Initialize();
 #endif
     platform_linux::PlatformLinux::Initialize();
+    std::call_once(TestUtilities::g_debugger_initialize_flag,
+                   []() { Debugger::Initialize(nullptr); });
   }
   void TearDown() override {
 #ifdef _WIN32
@@ -106,6 +111,18 @@ public:
 
   bool IsStillAtLastBreakpointHit() override { return true; }
 };
+
+class UnwindRecordingThread : public DummyThread {
+public:
+  using DummyThread::DummyThread;
+
+  lldb::StackFrameSP GetStackFrameAtIndex(uint32_t idx) override {
+    m_requested_frame = idx;
+    return nullptr;
+  }
+
+  std::atomic<int64_t> m_requested_frame = -1;
+};
 } // namespace
 
 TargetSP CreateTarget(DebuggerSP &debugger_sp, ArchSpec &arch) {
@@ -228,3 +245,41 @@ TEST_F(ThreadTest, GetPrivateStopInfo) {
   StopInfoSP new_stopinfo_sp = thread_sp->GetPrivateStopInfo();
   ASSERT_TRUE(new_stopinfo_sp && stopinfo_sp->IsValid() == true);
 }
+
+TEST_F(ThreadTest, PrefetchStackFrames) {
+  ArchSpec arch("powerpc64-pc-linux");
+
+  Platform::SetHostPlatform(
+      platform_linux::PlatformLinux::CreateInstance(true, &arch));
+
+  DebuggerSP debugger_sp = Debugger::CreateInstance();
+  ASSERT_TRUE(debugger_sp);
+
+  TargetSP target_sp = CreateTarget(debugger_sp, arch);
+  ASSERT_TRUE(target_sp);
+
+  ListenerSP listener_sp(Listener::MakeListener("dummy"));
+  ProcessSP process_sp = std::make_shared<DummyProcess>(target_sp, listener_sp);
+  ASSERT_TRUE(process_sp);
+
+  ThreadList &thread_list = process_sp->GetThreadList();
+  std::vector<std::shared_ptr<UnwindRecordingThread>> threads;
+  for (lldb::tid_t tid = 1; tid <= 3; ++tid) {
+    threads.push_back(
+        std::make_shared<UnwindRecordingThread>(*process_sp.get(), tid));
+    thread_list.AddThread(threads.back());
+  }
+
+  // Threads that are not in the list are skipped, and threads that were not
+  // asked for are left alone.
+  thread_list.PrefetchStackFrames({1, 3, 42}, 5);
+  EXPECT_EQ(threads[0]->m_requested_frame, 4);
+  EXPECT_EQ(threads[1]->m_requested_frame, -1);
+  EXPECT_EQ(threads[2]->m_requested_frame, 4);
+
+  // A single thread is cheaper to unwind by the caller itself.
+  thread_list.PrefetchStackFrames({2}, 5);
+  EXPECT_EQ(threads[1]->m_requested_frame, -1);
+
+  thread_list.Clear();
+}
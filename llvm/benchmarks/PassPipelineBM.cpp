@@ -0,0 +1,224 @@
+//===- PassPipelineBM.cpp -------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// These benchmarks measure the compile time of the default -O2/-O3 module
+// pipelines on synthetic inputs that stress different parts of the optimizer:
+// vectorizable loops, deep chains of small inlinable functions, and a single
+// large function with many branches. Inputs are generated as textual IR so
+// that they stay stable and readable, and parsing is excluded from the timing.
+// The pipelines are built for the host target, so that target-dependent
+// passes such as the vectorizers see real cost models.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/Analysis/CGSCCPassManager.h"
+#include "llvm/Analysis/LoopAnalysisManager.h"
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/PassManager.h"
+#include "llvm/MC/TargetRegistry.h"
+#include "llvm/Passes/OptimizationLevel.h"
+#include "llvm/Passes/PassBuilder.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Target/TargetMachine.h"
+#include "llvm/Target/TargetOptions.h"
+#include "llvm/TargetParser/Host.h"
+#include "llvm/TargetParser/SubtargetFeature.h"
+#include <memory>
+#include <string>
+
+using namespace llvm;
+
+/// Returns a TargetMachine for the host, or nullptr if the native target is
+/// not available.
+static std::unique_ptr<TargetMachine> createHostTargetMachine() {
+  if (InitializeNativeTarget())
+    return nullptr;
+  Triple TT(sys::getProcessTriple());
+  std::string Error;
+  const Target *T = TargetRegistry::lookupTarget(TT, Error);
+  if (!T)
+    return nullptr;
+  SubtargetFeatures Features;
+  for (const auto &[Feature, IsEnabled] : sys::getHostCPUFeatures())
+    Features.AddFeature(Feature, IsEnabled);
+  return std::unique_ptr<TargetMachine>(T->createTargetMachine(
+      TT, sys::getHostCPUName(), Features.getString(), TargetOptions(),
+      std::nullopt));
+}
+
+static std::unique_ptr<Module> parseIR(LLVMContext &C, const std::string &IR,
+                                       const TargetMachine &TM) {
+  SMDiagnostic Err;
+  std::unique_ptr<Module> M = parseAssemblyString(IR, Err, C);
+  if (!M) {
+    Err.print("PassPipelineBM", errs());
+    return nullptr;
+  }
+  M->setTargetTriple(TM.getTargetTriple());
+  M->setDataLayout(TM.createDataLayout());
+  return M;
+}
+
+/// \p N independent saxpy-style loops, which exercise the loop and
+/// vectorization passes.
+static std::string genNumericKernels(unsigned N) {
+  std::string IR;
+  raw_string_ostream OS(IR);
+  for (unsigned I = 0; I != N; ++I) {
+    OS << "define void @kernel" << I
+       << "(ptr noalias %y, ptr noalias %x, float %a, i64 %n) {\n"
+       << "entry:\n"
+       << "  %nonempty = icmp sgt i64 %n, 0\n"
+       << "  br i1 %nonempty, label %loop, label %exit\n"
+       << "loop:\n"
+       << "  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]\n"
+       << "  %px = getelementptr inbounds float, ptr %x, i64 %i\n"
+       << "  %py = getelementptr inbounds float, ptr %y, i64 %i\n"
+       << "  %vx = load float, ptr %px\n"
+       << "  %vy = load float, ptr %py\n"
+       << "  %m = fmul float %a, %vx\n"
+       << "  %s = fadd float %m, %vy\n"
+       << "  store float %s, ptr %py\n"
+       << "  %i.next = add nuw nsw i64 %i, 1\n"
+       << "  %more = icmp slt i64 %i.next, %n\n"
+       << "  br i1 %more, label %loop, label %exit\n"
+       << "exit:\n"
+       << "  ret void\n"
+       << "}\n";
+  }
+  return IR;
+}
+
+/// A chain of \p N small linkonce_odr functions, each calling the previous
+/// one, similar to what template-heavy C++ produces. This exercises the
+/// inliner and the CGSCC pipeline.
+static std::string genCallChain(unsigned N) {
+  std::string IR;
+  raw_string_ostream OS(IR);
+  OS << "define linkonce_odr i32 @f0(i32 %x) {\n"
+     << "  %r = add i32 %x, 1\n"
+     << "  ret i32 %r\n"
+     << "}\n";
+  for (unsigned I = 1; I != N; ++I) {
+    OS << "define linkonce_odr i32 @f" << I << "(i32 %x) {\n"
+       << "  %a = call i32 @f" << I - 1 << "(i32 %x)\n"
+       << "  %b = add i32 %a, " << I << "\n"
+       << "  %c = mul i32 %b, 3\n"
+       << "  ret i32 %c\n"
+       << "}\n";
+  }
+  OS << "define i32 @entry(i32 %x) {\n"
+     << "  %r = call i32 @f" << N - 1 << "(i32 %x)\n"
+     << "  ret i32 %r\n"
+     << "}\n";
+  return IR;
+}
+
+/// A single function made of \p N if-then-else diamonds, as found in large
+/// generated code. This exercises the scalar passes on big CFGs.
+static std::string genBranchyFunction(unsigned N) {
+  std::string IR;
+  raw_string_ostream OS(IR);
+  OS << "define i32 @branchy(i32 %v0) {\n"
+     << "entry:\n"
+     << "  br label %bb0\n";
+  for (unsigned I = 0; I != N; ++I) {
+    OS << "bb" << I << ":\n"
+       << "  %c" << I << " = icmp slt i32 %v" << I << ", " << I << "\n"
+       << "  br i1 %c" << I << ", label %t" << I << ", label %e" << I << "\n"
+       << "t" << I << ":\n"
+       << "  %a" << I << " = add i32 %v" << I << ", " << I << "\n"
+       << "  br label %j" << I << "\n"
+       << "e" << I << ":\n"
+       << "  %b" << I << " = mul i32 %v" << I << ", " << I + 1 << "\n"
+       << "  br label %j" << I << "\n"
+       << "j" << I << ":\n"
+       << "  %v" << I + 1 << " = phi i32 [ %a" << I << ", %t" << I
+       << " ], [ %b" << I << ", %e" << I << " ]\n"
+       << "  br label %bb" << I + 1 << "\n";
+  }
+  OS << "bb" << N << ":\n"
+     << "  ret i32 %v" << N << "\n"
+     << "}\n";
+  return IR;
+}
+
+static void runDefaultPipeline(Module &M, TargetMachine &TM,
+                               OptimizationLevel Level) {
+  LoopAnalysisManager LAM;
+  FunctionAnalysisManager FAM;
+  CGSCCAnalysisManager CGAM;
+  ModuleAnalysisManager MAM;
+  PassBuilder PB(&TM);
+  PB.registerModuleAnalyses(MAM);
+  PB.registerCGSCCAnalyses(CGAM);
+  PB.registerFunctionAnalyses(FAM);
+  PB.registerLoopAnalyses(LAM);
+  PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
+  ModulePassManager MPM = PB.buildPerModuleDefaultPipeline(Level);
+  MPM.run(M, MAM);
+}
+
+template <std::string (*GenerateIR)(unsigned)>
+static void runBenchmark(benchmark::State &State, OptimizationLevel Level) {
+  std::unique_ptr<TargetMachine> TM = createHostTargetMachine();
+  if (!TM) {
+    State.SkipWithError("no target available for the host");
+    return;
+  }
+  std::string IR = GenerateIR(State.range(0));
+  for (auto _ : State) {
+    State.PauseTiming();
+    auto C = std::make_unique<LLVMContext>();
+    std::unique_ptr<Module> M = parseIR(*C, IR, *TM);
+    if (!M) {
+      State.SkipWithError("failed to parse the generated IR");
+      break;
+    }
+    State.ResumeTiming();
+    runDefaultPipeline(*M, *TM, Level);
+    // Tear down the module and its context outside the timed region.
+    State.PauseTiming();
+    M.reset();
+    C.reset();
+    State.ResumeTiming();
+  }
+}
+
+static void BM_O2_NumericKernels(benchmark::State &State) {
+  runBenchmark<genNumericKernels>(State, OptimizationLevel::O2);
+}
+static void BM_O3_NumericKernels(benchmark::State &State) {
+  runBenchmark<genNumericKernels>(State, OptimizationLevel::O3);
+}
+static void BM_O2_CallChain(benchmark::State &State) {
+  runBenchmark<genCallChain>(State, OptimizationLevel::O2);
+}
+static void BM_O3_CallChain(benchmark::State &State) {
+  runBenchmark<genCallChain>(State, OptimizationLevel::O3);
+}
+static void BM_O2_BranchyFunction(benchmark::State &State) {
+  runBenchmark<genBranchyFunction>(State, OptimizationLevel::O2);
+}
+static void BM_O3_BranchyFunction(benchmark::State &State) {
+  runBenchmark<genBranchyFunction>(State, OptimizationLevel::O3);
+}
+
+BENCHMARK(BM_O2_NumericKernels)->Arg(16)->Arg(128);
+BENCHMARK(BM_O3_NumericKernels)->Arg(16)->Arg(128);
+BENCHMARK(BM_O2_CallChain)->Arg(64)->Arg(512);
+BENCHMARK(BM_O3_CallChain)->Arg(64)->Arg(512);
+BENCHMARK(BM_O2_BranchyFunction)->Arg(256)->Arg(2048);
+BENCHMARK(BM_O3_BranchyFunction)->Arg(256)->Arg(2048);
+
+BENCHMARK_MAIN();
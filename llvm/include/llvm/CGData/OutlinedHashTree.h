@@ -66,7 +66,7 @@ public:
   }
 
   /// \returns true if the hash tree has only the root node.
-  bool empty() { return size() == 1; }
+  bool empty() const { return Root.Successors.empty(); }
 
   /// \returns the size of a OutlinedHashTree by traversing it. If
   /// \p GetTerminalCountOnly is true, it only counts the terminal nodes
@@ -14,6 +14,7 @@
 #ifndef LLVM_CODEGEN_MACHINESTABLEHASH_H
 #define LLVM_CODEGEN_MACHINESTABLEHASH_H
 
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/StableHashing.h"
 #include "llvm/Support/Compiler.h"
 
@@ -31,6 +32,21 @@ LLVM_ABI stable_hash stableHashValue(const MachineInstr &MI,
 LLVM_ABI stable_hash stableHashValue(const MachineBasicBlock &MBB);
 LLVM_ABI stable_hash stableHashValue(const MachineFunction &MF);
 
+/// The position of each block of a function in layout order, counted from the
+/// entry block. Unlike block numbers, positions do not change when the
+/// function is renumbered.
+using MachineBlockPositions = DenseMap<const MachineBasicBlock *, unsigned>;
+LLVM_ABI MachineBlockPositions
+getMachineBlockPositions(const MachineFunction &MF);
+
+/// A stable hash value for \p MBB and its successor edges, as used by the
+/// MachineFunction overload. Block operands and successors are hashed by
+/// their entry in \p Positions, which should be computed once per function.
+/// Debug instructions are ignored. Returns 0 if any other instruction has no
+/// stable hash.
+LLVM_ABI stable_hash stableHashValue(const MachineBasicBlock &MBB,
+                                     const MachineBlockPositions &Positions);
+
 } // namespace llvm
 
 #endif
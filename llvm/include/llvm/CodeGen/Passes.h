@@ -224,6 +224,12 @@ LLVM_ABI FunctionPass *createFastRegisterAllocator(RegAllocFilterFunc F,
 LLVM_ABI FunctionPass *createBasicRegisterAllocator();
 LLVM_ABI FunctionPass *createBasicRegisterAllocator(RegAllocFilterFunc F);
 
+/// LinearScanRegisterAllocation Pass - This pass uses the basic regalloc
+/// framework, allocating live ranges in order of their start index.
+///
+LLVM_ABI FunctionPass *createLinearScanRegisterAllocator();
+LLVM_ABI FunctionPass *createLinearScanRegisterAllocator(RegAllocFilterFunc F);
+
 /// Greedy register allocation pass - This pass implements a global register
 /// allocator for optimized builds.
 ///
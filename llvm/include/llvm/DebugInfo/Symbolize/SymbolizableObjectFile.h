@@ -93,6 +93,19 @@ private:
   // (index, filename) pairs of ELF STT_FILE symbols.
   std::vector<std::pair<uint32_t, StringRef>> FileSymbols;
 
+  struct TextSectionDesc {
+    uint64_t Addr;
+    uint64_t End;
+    uint64_t Index;
+  };
+  // Non-empty text sections in section order, used to map addresses to
+  // section indices without walking every section of the object.
+  std::vector<TextSectionDesc> TextSections;
+  // True if TextSections is sorted by address and the ranges don't overlap,
+  // which holds for linked images and allows a binary search. Relocatable
+  // objects place all sections at 0 and need the first match in order.
+  bool TextSectionsAreDisjoint = true;
+
   SymbolizableObjectFile(const object::ObjectFile *Obj,
                          std::unique_ptr<DIContext> DICtx,
                          bool UntagAddresses);
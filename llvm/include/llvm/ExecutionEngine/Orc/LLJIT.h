@@ -321,6 +321,7 @@ public:
   ProcessSymbolsJITDylibSetupFunction SetupProcessSymbolsJITDylib;
   ObjectLinkingLayerCreator CreateObjectLinkingLayer;
   CompileFunctionCreator CreateCompileFunction;
+  ObjectCache *ObjCache = nullptr;
   unique_function<Error(LLJIT &)> PrePlatformSetup;
   PlatformSetupFunction SetUpPlatform;
   NotifyCreatedFunction NotifyCreated;
@@ -422,6 +423,17 @@ public:
     return impl();
   }
 
+  /// Set an ObjectCache for the default compile function to query before
+  /// compiling a module and to notify after compiling one. A persistent cache
+  /// lets later sessions skip codegen for modules that were already compiled.
+  ///
+  /// The cache is not owned by the JIT and must outlive it. It is ignored if
+  /// a custom CompileFunctionCreator is set.
+  SetterImpl &setObjectCache(ObjectCache *ObjCache) {
+    impl().ObjCache = ObjCache;
+    return impl();
+  }
+
   /// Set a setup function to be run just before the PlatformSetupFunction is
   /// run.
   ///
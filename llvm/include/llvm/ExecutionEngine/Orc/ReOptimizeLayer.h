@@ -13,11 +13,13 @@
 #define LLVM_EXECUTIONENGINE_ORC_REOPTIMIZELAYER_H
 
 #include "llvm/ExecutionEngine/Orc/Core.h"
+#include "llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h"
 #include "llvm/ExecutionEngine/Orc/Layer.h"
 #include "llvm/ExecutionEngine/Orc/Mangling.h"
 #include "llvm/ExecutionEngine/Orc/RedirectionManager.h"
 #include "llvm/ExecutionEngine/Orc/ThreadSafeModule.h"
 #include "llvm/IR/IRBuilder.h"
+#include "llvm/Passes/OptimizationLevel.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Transforms/Utils/BasicBlockUtils.h"
 #include "llvm/Transforms/Utils/Cloning.h"
@@ -85,6 +87,15 @@ public:
     return Error::success();
   }
 
+  /// Returns a ReOptimizeFunc that runs the default per-module optimization
+  /// pipeline at \p Level over the module being reoptimized, using a target
+  /// machine created from \p JTMB for target-specific analyses. At O0 the
+  /// O0 pipeline is run instead. Combined with reoptimizeIfCallFrequent this
+  /// gives a simple two-tier policy: the first version is compiled as added,
+  /// and frequently called code is recompiled at \p Level.
+  static ReOptimizeFunc runDefaultPipeline(JITTargetMachineBuilder JTMB,
+                                           OptimizationLevel Level);
+
   // Create IR reoptimize request fucntion call.
   static void createReoptimizeCall(Module &M, Instruction &IP,
                                    GlobalVariable *ArgBuffer);
@@ -73,14 +73,16 @@ private:
 
   void launchCompile(ExecutorAddr FAddr) {
     SymbolNameSet CandidateSet;
-    // Copy CandidateSet is necessary, to avoid unsynchronized access to
-    // the datastructure.
+    // Take the CandidateSet out of the map: speculation for a given stub only
+    // needs to be launched once, and every later call through the stub would
+    // otherwise issue the same lookups again.
     {
       std::lock_guard<std::mutex> Lockit(ConcurrentAccess);
       auto It = GlobalSpecMap.find(FAddr);
       if (It == GlobalSpecMap.end())
         return;
-      CandidateSet = It->getSecond();
+      CandidateSet = std::move(It->getSecond());
+      GlobalSpecMap.erase(It);
     }
 
     SymbolDependenceMap SpeculativeLookUpImpls;
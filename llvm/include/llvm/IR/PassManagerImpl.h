@@ -167,11 +167,17 @@ inline void AnalysisManager<IRUnitT, ExtraArgTs...>::invalidate(
   if (PA.allAnalysesInSetPreserved<AllAnalysesOn<IRUnitT>>())
     return;
 
+  // Nor is there anything to do if no results are cached for this IR unit.
+  // Avoid inserting (and then erasing) an empty list for it in that case.
+  auto RLI = AnalysisResultLists.find(&IR);
+  if (RLI == AnalysisResultLists.end())
+    return;
+
   // Track whether each analysis's result is invalidated in
   // IsResultInvalidated.
   SmallDenseMap<AnalysisKey *, bool, 8> IsResultInvalidated;
   Invalidator Inv(IsResultInvalidated, AnalysisResults);
-  AnalysisResultListT &ResultsList = AnalysisResultLists[&IR];
+  AnalysisResultListT &ResultsList = RLI->second;
   for (auto &AnalysisResultPair : ResultsList) {
     // This is basically the same thing as Invalidator::invalidate, but we
     // can't call it here because we're operating on the type-erased result.
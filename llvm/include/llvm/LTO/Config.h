@@ -25,6 +25,7 @@
 #include "llvm/Support/Compiler.h"
 #include "llvm/Target/TargetOptions.h"
 
+#include <array>
 #include <functional>
 #include <optional>
 
@@ -127,6 +128,12 @@ struct Config {
   /// Name remapping file for profile data.
   std::string ProfileRemapping;
 
+  /// SHA1 digests of the contents of SampleProfile and ProfileRemapping, used
+  /// by computeLTOCacheKey. LTO::runThinLTO sets these before starting the
+  /// backends. If they are not set, computeLTOCacheKey reads the files.
+  std::optional<std::array<uint8_t, 20>> SampleProfileHash;
+  std::optional<std::array<uint8_t, 20>> ProfileRemappingHash;
+
   /// The directory to store .dwo files.
   std::string DwoDir;
 
@@ -525,7 +525,9 @@ public:
   InstrProfLookupTrait(IndexedInstrProf::HashT HashType, unsigned FormatVersion)
       : HashType(HashType), FormatVersion(FormatVersion) {}
 
-  using data_type = ArrayRef<NamedInstrProfRecord>;
+  /// The records point into DataBuffer, which is decoded afresh by every
+  /// ReadData call, so callers may move out of them.
+  using data_type = MutableArrayRef<NamedInstrProfRecord>;
 
   using internal_key_type = StringRef;
   using external_key_type = StringRef;
@@ -571,9 +573,10 @@ struct InstrProfReaderIndexBase {
   // iterator.
   virtual Error getRecords(ArrayRef<NamedInstrProfRecord> &Data) = 0;
 
-  // Read all the profile records with the key equal to FuncName
+  // Read all the profile records with the key equal to FuncName. The records
+  // are only valid until the next lookup, and may be moved from.
   virtual Error getRecords(StringRef FuncName,
-                                     ArrayRef<NamedInstrProfRecord> &Data) = 0;
+                           MutableArrayRef<NamedInstrProfRecord> &Data) = 0;
   virtual void advanceToNextKey() = 0;
   virtual bool atEnd() const = 0;
   virtual void setValueProfDataEndianness(llvm::endianness Endianness) = 0;
@@ -621,7 +624,7 @@ public:
 
   Error getRecords(ArrayRef<NamedInstrProfRecord> &Data) override;
   Error getRecords(StringRef FuncName,
-                   ArrayRef<NamedInstrProfRecord> &Data) override;
+                   MutableArrayRef<NamedInstrProfRecord> &Data) override;
   void advanceToNextKey() override { RecordIterator++; }
 
   bool atEnd() const override {
@@ -685,7 +688,7 @@ public:
   virtual ~InstrProfReaderRemapper() = default;
   virtual Error populateRemappings() { return Error::success(); }
   virtual Error getRecords(StringRef FuncName,
-                           ArrayRef<NamedInstrProfRecord> &Data) = 0;
+                           MutableArrayRef<NamedInstrProfRecord> &Data) = 0;
 };
 
 class IndexedMemProfReader {
@@ -852,6 +855,13 @@ public:
   Error getFunctionBitmap(StringRef FuncName, uint64_t FuncHash,
                           BitVector &Bitmap);
 
+  /// Fill Counts and Bitmap with the profile data for the given function name.
+  /// This looks the record up once, unlike calling getFunctionCounts and
+  /// getFunctionBitmap in turn.
+  Error getFunctionCountsAndBitmap(StringRef FuncName, uint64_t FuncHash,
+                                   std::vector<uint64_t> &Counts,
+                                   BitVector &Bitmap);
+
   /// Return the maximum of all known function counts.
   /// \c UseCS indicates whether to use the context-sensitive count.
   uint64_t getMaximumFunctionCount(bool UseCS) {
@@ -8,7 +8,8 @@
 //
 // This file defines the CachedFileStream and the localCache function, which
 // simplifies caching files on the local filesystem in a directory whose
-// contents are managed by a CachePruningPolicy.
+// contents are managed by a CachePruningPolicy. It also defines the CacheStore
+// interface, which allows layering a shared second level below such a cache.
 //
 //===----------------------------------------------------------------------===//
 
@@ -119,6 +120,42 @@ LLVM_ABI Expected<FileCache> localCache(
     const Twine &CacheDirectoryPathRef,
     AddBufferFn AddBuffer = [](size_t Task, const Twine &ModuleName,
                                std::unique_ptr<MemoryBuffer> MB) {});
+
+/// A content-addressed store that can back a FileCache as a second cache
+/// level, typically one that is shared between machines (e.g. a directory on
+/// a network file system or a remote cache service).
+///
+/// Implementations must be thread safe.
+class LLVM_ABI CacheStore {
+public:
+  virtual ~CacheStore();
+
+  /// Returns the contents stored under \p Key, or nullptr if there are none.
+  virtual Expected<std::unique_ptr<MemoryBuffer>> get(StringRef Key) = 0;
+
+  /// Stores \p Data under \p Key, replacing any existing entry.
+  virtual Error put(StringRef Key, StringRef Data) = 0;
+};
+
+/// Create a CacheStore that keeps each entry in a file in the directory
+/// \p DirectoryPath, using the same file naming scheme as localCache. The
+/// directory is created lazily the first time an entry is stored.
+LLVM_ABI std::unique_ptr<CacheStore>
+createDirectoryCacheStore(const Twine &DirectoryPath);
+
+/// Create a two-level cache on top of the cache \p Local (usually created by
+/// localCache) and the store \p Remote. Lookups are served by \p Local first.
+/// On a miss, \p Remote is queried and a hit is written into \p Local, which
+/// adds it to the link like any other hit. Files produced on a miss in both
+/// levels are committed to \p Local and then uploaded to \p Remote.
+///
+/// Errors from \p Remote never fail the lookup or the commit. They are passed
+/// to \p Warn (which may be called from several threads at once), and the
+/// cache then stops using \p Remote and behaves like \p Local. If \p Warn is
+/// empty, the errors are printed with WithColor::defaultWarningHandler.
+LLVM_ABI FileCache tieredCache(FileCache Local,
+                               std::shared_ptr<CacheStore> Remote,
+                               std::function<void(Error)> Warn = nullptr);
 } // namespace llvm
 
 #endif
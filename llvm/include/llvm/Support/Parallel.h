@@ -20,6 +20,7 @@
 #include <condition_variable>
 #include <functional>
 #include <mutex>
+#include <vector>
 
 namespace llvm {
 
@@ -56,6 +57,25 @@ inline unsigned getThreadIndex() { return 0; }
 inline size_t getThreadCount() { return 1; }
 #endif
 
+/// Scheduling counters of a single worker thread of the default executor.
+struct WorkerStats {
+  /// Number of tasks executed by this worker.
+  uint64_t TasksRun = 0;
+  /// Number of tasks this worker took from the queue of another worker.
+  uint64_t Steals = 0;
+  /// Number of times this worker went to sleep because no work was available.
+  uint64_t IdleWaits = 0;
+};
+
+/// Returns the scheduling counters of all worker threads of the default
+/// executor, indexed by thread index. This is intended for tuning and may be
+/// called at any time; the counters are sampled without synchronization.
+#if LLVM_ENABLE_THREADS
+LLVM_ABI std::vector<WorkerStats> getWorkerStats();
+#else
+inline std::vector<WorkerStats> getWorkerStats() { return {}; }
+#endif
+
 namespace detail {
 class Latch {
   uint32_t Count;
@@ -84,6 +104,11 @@ public:
     std::unique_lock<std::mutex> lock(Mutex);
     Cond.wait(lock, [&] { return Count == 0; });
   }
+
+  bool isDone() const {
+    std::lock_guard<std::mutex> lock(Mutex);
+    return Count == 0;
+  }
 };
 } // namespace detail
 
@@ -100,7 +125,10 @@ public:
   // exactly in the order which they were spawned.
   LLVM_ABI void spawn(std::function<void()> f);
 
-  void sync() const { L.sync(); }
+  // Wait for all spawned tasks to finish. When called from a worker thread of
+  // the default executor, the calling thread first runs the queued tasks of
+  // this group, then blocks until the ones running elsewhere finish.
+  LLVM_ABI void sync() const;
 
   bool isParallel() const { return Parallel; }
 };
@@ -30,7 +30,13 @@ class TimeRecord {
   double UserTime = 0.0;             ///< User time elapsed.
   double SystemTime = 0.0;           ///< System time elapsed.
   ssize_t MemUsed = 0;               ///< Memory allocated (in bytes).
-  uint64_t InstructionsExecuted = 0; ///< Number of instructions executed
+  /// Number of user-space instructions executed, or zero if unavailable. On
+  /// Darwin this counts the whole process; on Linux it counts the calling
+  /// thread via perf_event_open. Timer reports such as -time-passes add an
+  /// "Instr" column (".instr" in JSON) whenever it is non-zero, so on Linux
+  /// hosts that allow unprivileged perf events that column now appears too.
+  uint64_t InstructionsExecuted = 0;
+
 public:
   TimeRecord() = default;
 
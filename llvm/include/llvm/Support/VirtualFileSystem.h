@@ -14,9 +14,11 @@
 #ifndef LLVM_SUPPORT_VIRTUALFILESYSTEM_H
 #define LLVM_SUPPORT_VIRTUALFILESYSTEM_H
 
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/IntrusiveRefCntPtr.h"
 #include "llvm/ADT/STLFunctionalExtras.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Chrono.h"
 #include "llvm/Support/Compiler.h"
@@ -825,14 +827,27 @@ public:
   /// A directory in the vfs with explicitly specified contents.
   class DirectoryEntry : public Entry {
     std::vector<std::unique_ptr<Entry>> Contents;
+    /// Positions in Contents keyed by lowercased name. Only maintained for
+    /// directories with at least IndexThreshold entries, none of which has an
+    /// empty name (those match any path component).
+    StringMap<SmallVector<unsigned, 1>> ContentsByName;
+    bool HasEmptyNamedContent = false;
     Status S;
 
+    static constexpr size_t IndexThreshold = 32;
+
+    LLVM_ABI void indexContent(unsigned I);
+
   public:
     /// Constructs a directory entry with explicitly specified contents.
     DirectoryEntry(StringRef Name, std::vector<std::unique_ptr<Entry>> Contents,
                    Status S)
         : Entry(EK_Directory, Name), Contents(std::move(Contents)),
-          S(std::move(S)) {}
+          S(std::move(S)) {
+      if (this->Contents.size() >= IndexThreshold)
+        for (unsigned I = 0, E = this->Contents.size(); I != E; ++I)
+          indexContent(I);
+    }
 
     /// Constructs an empty directory entry.
     DirectoryEntry(StringRef Name, Status S)
@@ -842,10 +857,24 @@ public:
 
     void addContent(std::unique_ptr<Entry> Content) {
       Contents.push_back(std::move(Content));
+      if (Contents.size() == IndexThreshold) {
+        for (unsigned I = 0; I != IndexThreshold; ++I)
+          indexContent(I);
+      } else if (Contents.size() > IndexThreshold) {
+        indexContent(Contents.size() - 1);
+      }
     }
 
     Entry *getLastContent() const { return Contents.back().get(); }
 
+    Entry *getContent(unsigned I) const { return Contents[I].get(); }
+
+    /// If this directory is indexed, returns the positions of the entries
+    /// whose names equal \p Name ignoring case, in order. Otherwise returns
+    /// std::nullopt and every entry has to be considered.
+    LLVM_ABI std::optional<ArrayRef<unsigned>>
+    findContents(StringRef Name) const;
+
     using iterator = decltype(Contents)::iterator;
 
     iterator contents_begin() { return Contents.begin(); }
@@ -85,6 +85,23 @@ struct SimplifyCFGOptions {
     SpeculateUnpredictables = B;
     return *this;
   }
+
+  /// A run with these options is known to make no changes if a run with
+  /// \p LastOpt made none. The assumption cache is not compared.
+  bool isCompatibleWith(const SimplifyCFGOptions &LastOpt) const {
+    return BonusInstThreshold == LastOpt.BonusInstThreshold &&
+           ForwardSwitchCondToPhi == LastOpt.ForwardSwitchCondToPhi &&
+           ConvertSwitchRangeToICmp == LastOpt.ConvertSwitchRangeToICmp &&
+           ConvertSwitchToLookupTable == LastOpt.ConvertSwitchToLookupTable &&
+           NeedCanonicalLoop == LastOpt.NeedCanonicalLoop &&
+           HoistCommonInsts == LastOpt.HoistCommonInsts &&
+           HoistLoadsStoresWithCondFaulting ==
+               LastOpt.HoistLoadsStoresWithCondFaulting &&
+           SinkCommonInsts == LastOpt.SinkCommonInsts &&
+           SimplifyCondBranch == LastOpt.SimplifyCondBranch &&
+           SpeculateBlocks == LastOpt.SpeculateBlocks &&
+           SpeculateUnpredictables == LastOpt.SpeculateUnpredictables;
+  }
 };
 
 } // namespace llvm
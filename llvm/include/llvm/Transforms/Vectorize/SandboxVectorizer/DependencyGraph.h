@@ -357,11 +357,14 @@ private:
   /// as it won't call AA. Therefore it returns the worst-case dep type.
   static DependencyType getRoughDepType(Instruction *FromI, Instruction *ToI);
 
-  // TODO: Implement AABudget.
   /// \Returns true if there is a memory/other dependency \p SrcI->DstI.
-  bool alias(Instruction *SrcI, Instruction *DstI, DependencyType DepType);
+  /// Each AA query consumes one unit of \p BudgetLeft. When it reaches zero
+  /// the dependency is conservatively assumed without querying AA.
+  bool alias(Instruction *SrcI, Instruction *DstI, DependencyType DepType,
+             unsigned &BudgetLeft);
 
-  bool hasDep(sandboxir::Instruction *SrcI, sandboxir::Instruction *DstI);
+  bool hasDep(sandboxir::Instruction *SrcI, sandboxir::Instruction *DstI,
+              unsigned &BudgetLeft);
 
   /// Go through all mem nodes in \p SrcScanRange and try to add dependencies to
   /// \p DstN.
@@ -659,13 +659,18 @@ bool CacheCost::populateReferenceGroups(ReferenceGroupsTy &RefGroups) const {
        // when in actuality, depending on the array size, the first example
        // should have a cost closer to 2x the second due to the two cache
        // access per iteration from opposite ends of the array
-        std::optional<bool> HasTemporalReuse =
-            R->hasTemporalReuse(Representative, *TRT, *InnerMostLoop, DI, AA);
+        // Check for spacial reuse first: it only compares subscripts, while
+        // the temporal reuse check runs a dependence query.
         std::optional<bool> HasSpacialReuse =
             R->hasSpacialReuse(Representative, CLS, AA);
+        bool HasReuse = HasSpacialReuse && *HasSpacialReuse;
+        if (!HasReuse) {
+          std::optional<bool> HasTemporalReuse = R->hasTemporalReuse(
+              Representative, *TRT, *InnerMostLoop, DI, AA);
+          HasReuse = HasTemporalReuse && *HasTemporalReuse;
+        }
 
-        if ((HasTemporalReuse && *HasTemporalReuse) ||
-            (HasSpacialReuse && *HasSpacialReuse)) {
+        if (HasReuse) {
           RefGroup.push_back(std::move(R));
           Added = true;
           break;
@@ -19,6 +19,7 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/iterator.h"
 #include "llvm/ADT/iterator_range.h"
@@ -60,6 +61,10 @@ using namespace llvm;
 
 #define DEBUG_TYPE "memoryssa"
 
+STATISTIC(NumClobberCacheHits,
+          "Number of clobber queries answered by a cached optimized access");
+STATISTIC(NumClobberWalks, "Number of upwards walks to find a clobber");
+
 static cl::opt<std::string>
     DotCFGMSSA("dot-cfg-mssa",
                cl::value_desc("file name for generated dot file"),
@@ -2551,8 +2556,10 @@ MemoryAccess *MemorySSA::ClobberWalkerBase::getClobberingMemoryAccessBase(
   // Note: Currently, we store the optimized def result in a separate field,
   // since we can't use the defining access.
   if (StartingAccess->isOptimized()) {
-    if (!SkipSelf || !isa<MemoryDef>(StartingAccess))
+    if (!SkipSelf || !isa<MemoryDef>(StartingAccess)) {
+      ++NumClobberCacheHits;
       return StartingAccess->getOptimized();
+    }
     IsOptimized = true;
   }
 
@@ -2583,6 +2590,7 @@ MemoryAccess *MemorySSA::ClobberWalkerBase::getClobberingMemoryAccessBase(
       return DefiningAccess;
     }
 
+    ++NumClobberWalks;
     OptimizedAccess =
         Walker.findClobber(BAA, DefiningAccess, Q, UpwardWalkLimit);
     StartingAccess->setOptimized(OptimizedAccess);
@@ -144,6 +144,12 @@ STATISTIC(NumExitCountsNotComputed,
           "Number of loop exits without predictable exit counts");
 STATISTIC(NumBruteForceTripCountsComputed,
           "Number of loops with trip counts computed by force");
+STATISTIC(NumArithLimitHit,
+          "Number of add/mul expressions not simplified due to depth or size "
+          "limits");
+STATISTIC(NumRangesComputedIteratively,
+          "Number of ranges computed iteratively for deeply nested "
+          "expressions");
 
 #ifdef EXPENSIVE_CHECKS
 bool llvm::VerifySCEV = true;
@@ -2542,8 +2548,10 @@ const SCEV *ScalarEvolution::getAddExpr(SmallVectorImpl<const SCEV *> &Ops,
   };
 
   // Limit recursion calls depth.
-  if (Depth > MaxArithDepth || hasHugeExpression(Ops))
+  if (Depth > MaxArithDepth || hasHugeExpression(Ops)) {
+    ++NumArithLimitHit;
     return getOrCreateAddExpr(Ops, ComputeFlags(Ops));
+  }
 
   if (SCEV *S = findExistingSCEVInCache(scAddExpr, Ops)) {
     // Don't strengthen flags if we have no new information.
@@ -3118,8 +3126,10 @@ const SCEV *ScalarEvolution::getMulExpr(SmallVectorImpl<const SCEV *> &Ops,
   };
 
   // Limit recursion calls depth.
-  if (Depth > MaxArithDepth || hasHugeExpression(Ops))
+  if (Depth > MaxArithDepth || hasHugeExpression(Ops)) {
+    ++NumArithLimitHit;
     return getOrCreateMulExpr(Ops, ComputeFlags(Ops));
+  }
 
   if (SCEV *S = findExistingSCEVInCache(scMulExpr, Ops)) {
     // Don't strengthen flags if we have no new information.
@@ -6642,8 +6652,10 @@ const ConstantRange &ScalarEvolution::getRangeRef(
 
   // Switch to iteratively computing the range for S, if it is part of a deeply
   // nested expression.
-  if (Depth > RangeIterThreshold)
+  if (Depth > RangeIterThreshold) {
+    ++NumRangesComputedIteratively;
     return getRangeRefIter(S, SignHint);
+  }
 
   unsigned BitWidth = getTypeSizeInBits(S->getType());
   ConstantRange ConservativeResult(BitWidth, /*isFullSet=*/true);
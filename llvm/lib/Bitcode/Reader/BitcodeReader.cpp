@@ -7018,18 +7018,19 @@ Error BitcodeReader::materialize(GlobalValue *GV) {
   if (DISubprogram *SP = MDLoader->lookupSubprogramForFunction(F))
     F->setSubprogram(SP);
 
-  // Check if the TBAA Metadata are valid, otherwise we will need to strip them.
-  if (!MDLoader->isStrippingTBAA()) {
-    for (auto &I : instructions(F)) {
+  // Walk the body once for all of the per-instruction checks and upgrades
+  // below; this is on the critical path when materializing large modules.
+  for (auto &I : instructions(F)) {
+    // Check if the TBAA Metadata are valid, otherwise we will need to strip
+    // them.
+    if (!MDLoader->isStrippingTBAA()) {
       MDNode *TBAA = I.getMetadata(LLVMContext::MD_tbaa);
-      if (!TBAA || TBAAVerifyHelper.visitTBAAMetadata(I, TBAA))
-        continue;
-      MDLoader->setStripTBAA(true);
-      stripTBAA(F->getParent());
+      if (TBAA && !TBAAVerifyHelper.visitTBAAMetadata(I, TBAA)) {
+        MDLoader->setStripTBAA(true);
+        stripTBAA(F->getParent());
+      }
     }
-  }
 
-  for (auto &I : instructions(F)) {
     // "Upgrade" older incorrect branch weights by dropping them.
     if (auto *MD = I.getMetadata(LLVMContext::MD_prof)) {
       if (MD->getOperand(0) != nullptr && isa<MDString>(MD->getOperand(0))) {
@@ -7060,15 +7061,20 @@ Error BitcodeReader::materialize(GlobalValue *GV) {
       }
     }
 
-    // Remove incompatible attributes on function calls.
+    // Remove incompatible attributes on function calls. Building the
+    // incompatibility mask is not free, so only do it for the return value and
+    // arguments that actually carry attributes.
     if (auto *CI = dyn_cast<CallBase>(&I)) {
-      CI->removeRetAttrs(AttributeFuncs::typeIncompatible(
-          CI->getFunctionType()->getReturnType(), CI->getRetAttributes()));
+      AttributeList Attrs = CI->getAttributes();
+      if (Attrs.hasRetAttrs())
+        CI->removeRetAttrs(AttributeFuncs::typeIncompatible(
+            CI->getFunctionType()->getReturnType(), Attrs.getRetAttrs()));
 
       for (unsigned ArgNo = 0; ArgNo < CI->arg_size(); ++ArgNo)
-        CI->removeParamAttrs(ArgNo, AttributeFuncs::typeIncompatible(
-                                        CI->getArgOperand(ArgNo)->getType(),
-                                        CI->getParamAttributes(ArgNo)));
+        if (Attrs.hasParamAttrs(ArgNo))
+          CI->removeParamAttrs(ArgNo, AttributeFuncs::typeIncompatible(
+                                          CI->getArgOperand(ArgNo)->getType(),
+                                          Attrs.getParamAttrs(ArgNo)));
     }
   }
 
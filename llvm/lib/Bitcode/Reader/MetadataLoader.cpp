@@ -80,6 +80,11 @@ static cl::opt<bool> DisableLazyLoading(
     cl::desc("Force disable the lazy-loading on-demand of metadata when "
              "loading bitcode for importing."));
 
+static cl::opt<bool> DisableImportCUListsPruning(
+    "disable-import-cu-lists-pruning", cl::init(false), cl::Hidden,
+    cl::desc("Load the enums, retained types, globals, imports and macros "
+             "lists of compile units when loading bitcode for importing."));
+
 namespace {
 
 static int64_t unrotateSign(uint64_t U) { return (U & 1) ? ~(U >> 1) : U >> 1; }
@@ -1870,12 +1875,24 @@ Error MetadataLoader::MetadataLoaderImpl::parseOneMetadata(
     // Ignore Record[0], which indicates whether this compile unit is
     // distinct.  It's always distinct.
     IsDistinct = true;
+
+    // When importing, the IRMover drops the enums, retained types, globals,
+    // imported entities and macros lists of the source compile units (see
+    // IRLinker::prepareCompileUnitsForImport). Don't materialize them: with
+    // lazy-loading they are the main reason for walking most of the module's
+    // metadata when importing a single function. Nodes from these lists that
+    // the imported IR does reference are still loaded on demand.
+    auto getCUListOrNull = [&](unsigned ID) -> Metadata * {
+      if (IsImporting && !DisableImportCUListsPruning)
+        return nullptr;
+      return getMDOrNull(ID);
+    };
     auto *CU = DICompileUnit::getDistinct(
         Context, Record[1], getMDOrNull(Record[2]), getMDString(Record[3]),
         Record[4], getMDString(Record[5]), Record[6], getMDString(Record[7]),
-        Record[8], getMDOrNull(Record[9]), getMDOrNull(Record[10]),
-        getMDOrNull(Record[12]), getMDOrNull(Record[13]),
-        Record.size() <= 15 ? nullptr : getMDOrNull(Record[15]),
+        Record[8], getCUListOrNull(Record[9]), getCUListOrNull(Record[10]),
+        getCUListOrNull(Record[12]), getCUListOrNull(Record[13]),
+        Record.size() <= 15 ? nullptr : getCUListOrNull(Record[15]),
         Record.size() <= 14 ? 0 : Record[14],
         Record.size() <= 16 ? true : Record[16],
         Record.size() <= 17 ? false : Record[17],
@@ -5370,7 +5370,9 @@ void ModuleBitcodeWriter::write() {
   writeSyncScopeNames();
 
   // Emit function bodies.
+  // FIXME: Encode function blocks in parallel once ValueEnumerator allows it.
   DenseMap<const Function *, uint64_t> FunctionToBitcodeIndex;
+  FunctionToBitcodeIndex.reserve(M.size());
   for (const Function &F : M)
     if (!F.isDeclaration())
       writeFunction(F, FunctionToBitcodeIndex);
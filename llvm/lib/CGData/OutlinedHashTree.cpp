@@ -73,15 +73,12 @@ void OutlinedHashTree::insert(const HashSequencePair &SequencePair) {
   HashNode *Current = getRoot();
 
   for (stable_hash StableHash : Sequence) {
-    auto I = Current->Successors.find(StableHash);
-    if (I == Current->Successors.end()) {
-      std::unique_ptr<HashNode> Next = std::make_unique<HashNode>();
-      HashNode *NextPtr = Next.get();
-      NextPtr->Hash = StableHash;
-      Current->Successors.emplace(StableHash, std::move(Next));
-      Current = NextPtr;
-    } else
-      Current = I->second.get();
+    auto [I, Inserted] = Current->Successors.try_emplace(StableHash);
+    if (Inserted) {
+      I->second = std::make_unique<HashNode>();
+      I->second->Hash = StableHash;
+    }
+    Current = I->second.get();
   }
   if (Count)
     Current->Terminals = Current->Terminals.value_or(0) + Count;
@@ -100,17 +97,12 @@ void OutlinedHashTree::merge(const OutlinedHashTree *Tree) {
     if (SrcNode->Terminals)
       DstNode->Terminals = DstNode->Terminals.value_or(0) + *SrcNode->Terminals;
     for (auto &[Hash, NextSrcNode] : SrcNode->Successors) {
-      HashNode *NextDstNode;
-      auto I = DstNode->Successors.find(Hash);
-      if (I == DstNode->Successors.end()) {
-        auto NextDst = std::make_unique<HashNode>();
-        NextDstNode = NextDst.get();
-        NextDstNode->Hash = Hash;
-        DstNode->Successors.emplace(Hash, std::move(NextDst));
-      } else
-        NextDstNode = I->second.get();
-
-      Stack.emplace_back(NextDstNode, NextSrcNode.get());
+      auto [I, Inserted] = DstNode->Successors.try_emplace(Hash);
+      if (Inserted) {
+        I->second = std::make_unique<HashNode>();
+        I->second->Hash = Hash;
+      }
+      Stack.emplace_back(I->second.get(), NextSrcNode.get());
     }
   }
 }
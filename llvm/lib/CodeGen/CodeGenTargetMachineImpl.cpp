@@ -231,6 +231,7 @@ bool CodeGenTargetMachineImpl::addPassesToEmitFile(
   if (!PassConfig)
     return true;
 
+  // FIXME: Machine passes cannot run on several functions concurrently yet.
   if (TargetPassConfig::willCompleteCodeGenPipeline()) {
     if (addAsmPrinter(PM, Out, DwoOut, FileType, MMIWP->getMMI().getContext()))
       return true;
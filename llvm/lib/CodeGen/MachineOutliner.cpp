@@ -180,6 +180,12 @@ struct InstructionMapper {
   /// at index i in \p UnsignedVec for each index i.
   SmallVector<MachineBasicBlock::iterator> InstrList;
 
+  /// Scratch buffers for the block currently being mapped. They are only
+  /// appended to \p UnsignedVec and \p InstrList if the block has a legal
+  /// range, and are kept across blocks so that their storage is reused.
+  SmallVector<unsigned> UnsignedVecForMBB;
+  SmallVector<MachineBasicBlock::iterator> InstrListForMBB;
+
   // Set if we added an illegal number in the previous step.
   // Since each illegal number is unique, we only need one of them between
   // each range of legal numbers. This lets us make sure we don't add more
@@ -325,8 +331,8 @@ struct InstructionMapper {
 
     // FIXME: Should this all just be handled in the target, rather than using
     // repeated calls to getOutliningType?
-    SmallVector<unsigned> UnsignedVecForMBB;
-    SmallVector<MachineBasicBlock::iterator> InstrListForMBB;
+    UnsignedVecForMBB.clear();
+    InstrListForMBB.clear();
 
     LLVM_DEBUG(dbgs() << "*** Mapping outlinable ranges ***\n");
     for (auto &OutlinableRange : OutlinableRanges) {
@@ -14,6 +14,7 @@
 #include "llvm/CodeGen/MachineStableHash.h"
 #include "llvm/ADT/APFloat.h"
 #include "llvm/ADT/APInt.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StableHashing.h"
@@ -180,13 +181,13 @@ stable_hash llvm::stableHashValue(const MachineOperand &MO) {
   llvm_unreachable("Invalid machine operand type");
 }
 
-/// A stable hash value for machine instructions.
-/// Returns 0 if no stable hash could be computed.
-/// The hashing and equality testing functions ignore definitions so this is
-/// useful for CSE, etc.
-stable_hash llvm::stableHashValue(const MachineInstr &MI, bool HashVRegs,
-                                  bool HashConstantPoolIndices,
-                                  bool HashMemOperands) {
+/// Hashes \p MI. If \p BlockPositions is given, basic block operands are
+/// hashed by the position of the block in it instead of making the
+/// instruction unhashable.
+static stable_hash
+stableHashInstr(const MachineInstr &MI, bool HashVRegs,
+                bool HashConstantPoolIndices, bool HashMemOperands,
+                const MachineBlockPositions *BlockPositions) {
   // Build up a buffer of hash code components.
   SmallVector<stable_hash, 16> HashComponents;
   HashComponents.reserve(MI.getNumOperands() + MI.getNumMemOperands() + 2);
@@ -202,6 +203,13 @@ stable_hash llvm::stableHashValue(const MachineInstr &MI, bool HashVRegs,
       continue;
     }
 
+    if (MO.isMBB() && BlockPositions) {
+      HashComponents.push_back(
+          stable_hash_combine(MO.getType(), MO.getTargetFlags(),
+                              BlockPositions->lookup(MO.getMBB())));
+      continue;
+    }
+
     stable_hash StableHash = stableHashValue(MO);
     if (!StableHash)
       return 0;
@@ -224,6 +232,45 @@ stable_hash llvm::stableHashValue(const MachineInstr &MI, bool HashVRegs,
   return stable_hash_combine(HashComponents);
 }
 
+/// A stable hash value for machine instructions.
+/// Returns 0 if no stable hash could be computed.
+/// The hashing and equality testing functions ignore definitions so this is
+/// useful for CSE, etc.
+stable_hash llvm::stableHashValue(const MachineInstr &MI, bool HashVRegs,
+                                  bool HashConstantPoolIndices,
+                                  bool HashMemOperands) {
+  return stableHashInstr(MI, HashVRegs, HashConstantPoolIndices,
+                         HashMemOperands, /*BlockPositions=*/nullptr);
+}
+
+MachineBlockPositions
+llvm::getMachineBlockPositions(const MachineFunction &MF) {
+  MachineBlockPositions Positions;
+  for (const MachineBasicBlock &MBB : MF)
+    Positions.try_emplace(&MBB, Positions.size());
+  return Positions;
+}
+
+stable_hash llvm::stableHashValue(const MachineBasicBlock &MBB,
+                                  const MachineBlockPositions &Positions) {
+  SmallVector<stable_hash> HashComponents;
+  // TODO: Hash more stuff like block alignment and branch probabilities.
+  for (const MachineInstr &MI : MBB) {
+    if (MI.isDebugInstr())
+      continue;
+    stable_hash StableHash =
+        stableHashInstr(MI, /*HashVRegs=*/false,
+                        /*HashConstantPoolIndices=*/false,
+                        /*HashMemOperands=*/false, &Positions);
+    if (!StableHash)
+      return 0;
+    HashComponents.push_back(StableHash);
+  }
+  for (const MachineBasicBlock *Succ : MBB.successors())
+    HashComponents.push_back(Positions.lookup(Succ));
+  return stable_hash_combine(HashComponents);
+}
+
 stable_hash llvm::stableHashValue(const MachineBasicBlock &MBB) {
   SmallVector<stable_hash> HashComponents;
   // TODO: Hash more stuff like block alignment and branch probabilities.
@@ -232,10 +279,17 @@ stable_hash llvm::stableHashValue(const MachineBasicBlock &MBB) {
   return stable_hash_combine(HashComponents);
 }
 
+/// A stable hash value for a machine function.
+/// Returns 0 if any block has no stable hash.
 stable_hash llvm::stableHashValue(const MachineFunction &MF) {
+  MachineBlockPositions Positions = getMachineBlockPositions(MF);
   SmallVector<stable_hash> HashComponents;
   // TODO: Hash lots more stuff like function alignment and stack objects.
-  for (const auto &MBB : MF)
-    HashComponents.push_back(stableHashValue(MBB));
+  for (const MachineBasicBlock &MBB : MF) {
+    stable_hash StableHash = stableHashValue(MBB, Positions);
+    if (!StableHash)
+      return 0;
+    HashComponents.push_back(StableHash);
+  }
   return stable_hash_combine(HashComponents);
 }
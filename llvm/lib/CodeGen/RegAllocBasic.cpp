@@ -42,10 +42,41 @@ using namespace llvm;
 static RegisterRegAlloc basicRegAlloc("basic", "basic register allocator",
                                       createBasicRegisterAllocator);
 
+static RegisterRegAlloc
+    linearScanRegAlloc("linearscan", "linear scan register allocator",
+                       createLinearScanRegisterAllocator);
+
 namespace {
-  struct CompSpillWeight {
-    bool operator()(const LiveInterval *A, const LiveInterval *B) const {
-      return A->weight() < B->weight();
+  /// An entry in the allocation queue. The start index and register are
+  /// captured when the live range is enqueued, since the live range itself may
+  /// be shrunk or erased while it is queued and the heap order must not change.
+  struct QueuedInterval {
+    const LiveInterval *LI;
+    /// Invalid for a live range that was empty when it was enqueued.
+    SlotIndex Start;
+    Register Reg;
+
+    explicit QueuedInterval(const LiveInterval *LI)
+        : LI(LI), Start(LI->empty() ? SlotIndex() : LI->beginIndex()),
+          Reg(LI->reg()) {}
+  };
+
+  /// Orders the allocation queue. By default the heaviest live range is
+  /// allocated first. In linear scan mode live ranges are allocated in order
+  /// of their start index instead.
+  struct CompLiveInterval {
+    bool LinearScan = false;
+
+    bool operator()(const QueuedInterval &A, const QueuedInterval &B) const {
+      if (LinearScan) {
+        // Dequeue empty ranges first so they can be dropped.
+        if (!A.Start.isValid() || !B.Start.isValid())
+          return A.Start.isValid() && !B.Start.isValid();
+        if (A.Start != B.Start)
+          return B.Start < A.Start;
+        return A.Reg > B.Reg;
+      }
+      return A.LI->weight() < B.LI->weight();
     }
   };
 }
@@ -56,6 +87,11 @@ namespace {
 /// whenever a register is unavailable. This is not practical in production but
 /// provides a useful baseline both for measuring other allocators and comparing
 /// the speed of the basic algorithm against other styles of allocators.
+///
+/// In linear scan mode, live ranges are visited in order of their start index
+/// rather than by spill weight. Lighter interfering ranges may still be evicted
+/// and spilled. This is intended for low-latency compiles where the greedy
+/// allocator is too slow.
 class RABasic : public MachineFunctionPass,
                 public RegAllocBase,
                 private LiveRangeEdit::Delegate {
@@ -64,22 +100,28 @@ class RABasic : public MachineFunctionPass,
 
   // state
   std::unique_ptr<Spiller> SpillerInstance;
-  std::priority_queue<const LiveInterval *, std::vector<const LiveInterval *>,
-                      CompSpillWeight>
+  std::priority_queue<QueuedInterval, std::vector<QueuedInterval>,
+                      CompLiveInterval>
       Queue;
 
   // Scratch space.  Allocated here to avoid repeated malloc calls in
   // selectOrSplit().
   BitVector UsableRegs;
 
+  /// Allocate live ranges in order of their start index.
+  bool LinearScan;
+
   bool LRE_CanEraseVirtReg(Register) override;
   void LRE_WillShrinkVirtReg(Register) override;
 
 public:
-  RABasic(const RegAllocFilterFunc F = nullptr);
+  RABasic(const RegAllocFilterFunc F = nullptr, bool LinearScan = false);
 
   /// Return the pass name.
-  StringRef getPassName() const override { return "Basic Register Allocator"; }
+  StringRef getPassName() const override {
+    return LinearScan ? "Linear Scan Register Allocator"
+                      : "Basic Register Allocator";
+  }
 
   /// RABasic analysis usage.
   void getAnalysisUsage(AnalysisUsage &AU) const override;
@@ -88,12 +130,14 @@ public:
 
   Spiller &spiller() override { return *SpillerInstance; }
 
-  void enqueueImpl(const LiveInterval *LI) override { Queue.push(LI); }
+  void enqueueImpl(const LiveInterval *LI) override {
+    Queue.push(QueuedInterval(LI));
+  }
 
   const LiveInterval *dequeue() override {
     if (Queue.empty())
       return nullptr;
-    const LiveInterval *LI = Queue.top();
+    const LiveInterval *LI = Queue.top().LI;
     Queue.pop();
     return LI;
   }
@@ -169,8 +213,9 @@ void RABasic::LRE_WillShrinkVirtReg(Register VirtReg) {
   enqueue(&LI);
 }
 
-RABasic::RABasic(RegAllocFilterFunc F)
-    : MachineFunctionPass(ID), RegAllocBase(F) {}
+RABasic::RABasic(RegAllocFilterFunc F, bool LinearScan)
+    : MachineFunctionPass(ID), RegAllocBase(F),
+      Queue(CompLiveInterval{LinearScan}), LinearScan(LinearScan) {}
 
 void RABasic::getAnalysisUsage(AnalysisUsage &AU) const {
   AU.setPreservesCFG();
@@ -342,3 +387,11 @@ FunctionPass* llvm::createBasicRegisterAllocator() {
 FunctionPass *llvm::createBasicRegisterAllocator(RegAllocFilterFunc F) {
   return new RABasic(F);
 }
+
+FunctionPass *llvm::createLinearScanRegisterAllocator() {
+  return new RABasic(nullptr, /*LinearScan=*/true);
+}
+
+FunctionPass *llvm::createLinearScanRegisterAllocator(RegAllocFilterFunc F) {
+  return new RABasic(F, /*LinearScan=*/true);
+}
@@ -119,6 +119,12 @@ static cl::opt<unsigned long> GrowRegionComplexityBudget(
              "limit its budget and bail out once we reach the limit."),
     cl::init(10000), cl::Hidden);
 
+static cl::opt<unsigned> GlobalSplitBudget(
+    "regalloc-budget",
+    cl::desc("Maximum number of global live range splits attempted per "
+             "function before falling back to spilling (0 = unlimited)"),
+    cl::init(0), cl::Hidden);
+
 static cl::opt<bool> GreedyRegClassPriorityTrumpsGlobalness(
     "greedy-regclass-priority-trumps-globalness",
     cl::desc("Change the greedy register allocator's live range priority "
@@ -1950,6 +1956,23 @@ MCRegister RAGreedy::trySplit(const LiveInterval &VirtReg,
     return tryInstructionSplit(VirtReg, Order, NewVRegs);
   }
 
+  // Global splitting does not scale to huge functions. Once the budget is
+  // exhausted, leave the remaining global ranges to the spiller.
+  if (GlobalSplitBudget && NumGlobalSplitAttempts >= GlobalSplitBudget) {
+    if (NumGlobalSplitAttempts++ == GlobalSplitBudget) {
+      ORE->emit([&]() {
+        DebugLoc Loc;
+        if (auto *SP = MF->getFunction().getSubprogram())
+          Loc = DILocation::get(SP->getContext(), SP->getLine(), 1, SP);
+        return MachineOptimizationRemarkMissed(DEBUG_TYPE, "SplitBudget", Loc,
+                                               &MF->front())
+               << "global live range splitting budget exhausted";
+      });
+    }
+    return MCRegister();
+  }
+  ++NumGlobalSplitAttempts;
+
   NamedRegionTimer T("global_split", "Global Splitting", TimerGroupName,
                      TimerGroupDescription, TimePassesIsEnabled);
 
@@ -2891,6 +2914,7 @@ bool RAGreedy::run(MachineFunction &mf) {
   IntfCache.init(MF, Matrix->getLiveUnions(), Indexes, LIS, TRI);
   GlobalCand.resize(32);  // This will grow as needed.
   SetOfBrokenHints.clear();
+  NumGlobalSplitAttempts = 0;
 
   allocatePhysRegs();
   tryHintsRecoloring();
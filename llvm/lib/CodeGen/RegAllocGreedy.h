@@ -210,6 +210,10 @@ private:
 
   uint8_t CutOffInfo = CutOffStage::CO_None;
 
+  /// Number of global live range splits attempted in the current function,
+  /// checked against -regalloc-budget.
+  unsigned NumGlobalSplitAttempts = 0;
+
 #ifndef NDEBUG
   static const char *const StageName[];
 #endif
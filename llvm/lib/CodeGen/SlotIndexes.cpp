@@ -48,6 +48,7 @@ INITIALIZE_PASS(SlotIndexesWrapperPass, DEBUG_TYPE, "Slot index numbering",
                 false, false)
 
 STATISTIC(NumLocalRenum,  "Number of local renumberings");
+STATISTIC(NumFullRenum,   "Number of full function numberings");
 
 void SlotIndexesWrapperPass::getAnalysisUsage(AnalysisUsage &au) const {
   au.setPreservesAll();
@@ -76,6 +77,7 @@ void SlotIndexes::analyze(MachineFunction &fn) {
   // only need to be set up once after the first numbering is computed.
 
   mf = &fn;
+  ++NumFullRenum;
 
   // Check that the list contains only the sentinel.
   assert(indexList.empty() && "Index list non-empty at initial numbering?");
@@ -118,8 +120,9 @@ void SlotIndexes::analyze(MachineFunction &fn) {
     idx2MBBMap.push_back(IdxMBBPair(blockStartIndex, &MBB));
   }
 
-  // Sort the Idx2MBBMap
-  llvm::sort(idx2MBBMap, less_first());
+  // Blocks are numbered in layout order, so Idx2MBBMap is already sorted.
+  assert(llvm::is_sorted(idx2MBBMap, less_first()) &&
+         "Idx2MBBMap not in index order");
 
   LLVM_DEBUG(mf->print(dbgs(), this));
 }
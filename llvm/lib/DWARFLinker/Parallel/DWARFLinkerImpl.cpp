@@ -1250,12 +1250,14 @@ void DWARFLinkerImpl::emitAppleAcceleratorSections(const Triple &TargetTriple) {
     });
   });
 
-  {
+  // Each table goes to its own section through its own emitter, so the four
+  // sections are emitted in parallel.
+  auto EmitTable = [&](DebugSectionKind Kind,
+                       function_ref<void(DwarfEmitterImpl &)> EmitFn) {
     // FIXME: we use AsmPrinter to emit accelerator sections.
     // It might be beneficial to directly emit accelerator data
     // to the raw_svector_ostream.
-    SectionDescriptor &OutSection =
-        CommonSections.getSectionDescriptor(DebugSectionKind::AppleNamespaces);
+    SectionDescriptor &OutSection = CommonSections.getSectionDescriptor(Kind);
     DwarfEmitterImpl Emitter(DWARFLinker::OutputFileType::Object,
                              OutSection.OS);
     if (Error Err = Emitter.init(TargetTriple, "__DWARF")) {
@@ -1264,75 +1266,31 @@ void DWARFLinkerImpl::emitAppleAcceleratorSections(const Triple &TargetTriple) {
     }
 
     // Emit table.
-    Emitter.emitAppleNamespaces(AppleNamespaces);
+    EmitFn(Emitter);
     Emitter.finish();
 
     // Set start offset and size for output section.
     OutSection.setSizesForSectionCreatedByAsmPrinter();
-  }
-
-  {
-    // FIXME: we use AsmPrinter to emit accelerator sections.
-    // It might be beneficial to directly emit accelerator data
-    // to the raw_svector_ostream.
-    SectionDescriptor &OutSection =
-        CommonSections.getSectionDescriptor(DebugSectionKind::AppleNames);
-    DwarfEmitterImpl Emitter(DWARFLinker::OutputFileType::Object,
-                             OutSection.OS);
-    if (Error Err = Emitter.init(TargetTriple, "__DWARF")) {
-      consumeError(std::move(Err));
-      return;
-    }
-
-    // Emit table.
-    Emitter.emitAppleNames(AppleNames);
-    Emitter.finish();
-
-    // Set start offset ans size for output section.
-    OutSection.setSizesForSectionCreatedByAsmPrinter();
-  }
-
-  {
-    // FIXME: we use AsmPrinter to emit accelerator sections.
-    // It might be beneficial to directly emit accelerator data
-    // to the raw_svector_ostream.
-    SectionDescriptor &OutSection =
-        CommonSections.getSectionDescriptor(DebugSectionKind::AppleObjC);
-    DwarfEmitterImpl Emitter(DWARFLinker::OutputFileType::Object,
-                             OutSection.OS);
-    if (Error Err = Emitter.init(TargetTriple, "__DWARF")) {
-      consumeError(std::move(Err));
-      return;
-    }
-
-    // Emit table.
-    Emitter.emitAppleObjc(AppleObjC);
-    Emitter.finish();
-
-    // Set start offset ans size for output section.
-    OutSection.setSizesForSectionCreatedByAsmPrinter();
-  }
-
-  {
-    // FIXME: we use AsmPrinter to emit accelerator sections.
-    // It might be beneficial to directly emit accelerator data
-    // to the raw_svector_ostream.
-    SectionDescriptor &OutSection =
-        CommonSections.getSectionDescriptor(DebugSectionKind::AppleTypes);
-    DwarfEmitterImpl Emitter(DWARFLinker::OutputFileType::Object,
-                             OutSection.OS);
-    if (Error Err = Emitter.init(TargetTriple, "__DWARF")) {
-      consumeError(std::move(Err));
-      return;
-    }
-
-    // Emit table.
-    Emitter.emitAppleTypes(AppleTypes);
-    Emitter.finish();
+  };
 
-    // Set start offset ans size for output section.
-    OutSection.setSizesForSectionCreatedByAsmPrinter();
-  }
+  llvm::parallel::TaskGroup TG;
+  TG.spawn([&]() {
+    EmitTable(DebugSectionKind::AppleNamespaces, [&](DwarfEmitterImpl &E) {
+      E.emitAppleNamespaces(AppleNamespaces);
+    });
+  });
+  TG.spawn([&]() {
+    EmitTable(DebugSectionKind::AppleNames,
+              [&](DwarfEmitterImpl &E) { E.emitAppleNames(AppleNames); });
+  });
+  TG.spawn([&]() {
+    EmitTable(DebugSectionKind::AppleObjC,
+              [&](DwarfEmitterImpl &E) { E.emitAppleObjc(AppleObjC); });
+  });
+  TG.spawn([&]() {
+    EmitTable(DebugSectionKind::AppleTypes,
+              [&](DwarfEmitterImpl &E) { E.emitAppleTypes(AppleTypes); });
+  });
 }
 
 void DWARFLinkerImpl::emitDWARFv5DebugNamesSection(const Triple &TargetTriple) {
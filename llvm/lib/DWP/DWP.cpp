@@ -18,6 +18,7 @@
 #include "llvm/MC/MCTargetOptionsCommandFlags.h"
 #include "llvm/Object/Decompressor.h"
 #include "llvm/Object/ELFObjectFile.h"
+#include "llvm/Support/Parallel.h"
 #include <limits>
 
 using namespace llvm;
@@ -654,22 +655,42 @@ Error write(MCStreamer &Out, ArrayRef<std::string> Inputs,
 
   DWPStringPool Strings(Out, StrSection);
 
+  // Opening and mapping the inputs is independent per file and dominated by
+  // I/O latency when there are many of them, so do it in parallel up front.
+  // The inputs are still processed in order below, which keeps the output
+  // deterministic.
+  std::vector<std::optional<Expected<OwningBinary<object::ObjectFile>>>>
+      OpenedInputs(Inputs.size());
+  parallelFor(0, Inputs.size(), [&](size_t I) {
+    OpenedInputs[I].emplace(object::ObjectFile::createObjectFile(Inputs[I]));
+  });
+
+  for (size_t I = 0, E = Inputs.size(); I != E; ++I) {
+    Expected<OwningBinary<object::ObjectFile>> &ErrOrObj = *OpenedInputs[I];
+    if (ErrOrObj)
+      continue;
+    // Report the first input that failed to open, and drop the errors of
+    // any later ones.
+    for (size_t J = I + 1; J != E; ++J)
+      if (!*OpenedInputs[J])
+        consumeError(OpenedInputs[J]->takeError());
+    return handleErrors(ErrOrObj.takeError(),
+                        [&](std::unique_ptr<ECError> EC) -> Error {
+                          return createFileError(Inputs[I],
+                                                 Error(std::move(EC)));
+                        });
+  }
+
   SmallVector<OwningBinary<object::ObjectFile>, 128> Objects;
   Objects.reserve(Inputs.size());
+  for (auto &ErrOrObj : OpenedInputs)
+    Objects.push_back(std::move(**ErrOrObj));
+  OpenedInputs.clear();
 
   std::deque<SmallString<32>> UncompressedSections;
 
-  for (const auto &Input : Inputs) {
-    auto ErrOrObj = object::ObjectFile::createObjectFile(Input);
-    if (!ErrOrObj) {
-      return handleErrors(ErrOrObj.takeError(),
-                          [&](std::unique_ptr<ECError> EC) -> Error {
-                            return createFileError(Input, Error(std::move(EC)));
-                          });
-    }
-
-    auto &Obj = *ErrOrObj->getBinary();
-    Objects.push_back(std::move(*ErrOrObj));
+  for (auto [Input, Object] : llvm::zip_equal(Inputs, Objects)) {
+    auto &Obj = *Object.getBinary();
 
     UnitIndexEntry CurEntry = {};
 
@@ -83,6 +83,15 @@ SymbolizableObjectFile::create(const object::ObjectFile *Obj,
   }
   SS.erase(J, SS.end());
 
+  for (SectionRef Sec : Obj->sections()) {
+    if (!Sec.isText() || Sec.isVirtual() || Sec.getSize() == 0)
+      continue;
+    uint64_t Addr = Sec.getAddress();
+    if (!res->TextSections.empty() && Addr < res->TextSections.back().End)
+      res->TextSectionsAreDisjoint = false;
+    res->TextSections.push_back({Addr, Addr + Sec.getSize(), Sec.getIndex()});
+  }
+
   return std::move(res);
 }
 
@@ -379,15 +388,19 @@ SymbolizableObjectFile::findSymbol(StringRef Symbol, uint64_t Offset) const {
 /// Search for the first occurence of specified Address in ObjectFile.
 uint64_t SymbolizableObjectFile::getModuleSectionIndexForAddress(
     uint64_t Address) const {
-
-  for (SectionRef Sec : Module->sections()) {
-    if (!Sec.isText() || Sec.isVirtual())
-      continue;
-
-    if (Address >= Sec.getAddress() &&
-        Address < Sec.getAddress() + Sec.getSize())
-      return Sec.getIndex();
+  if (TextSectionsAreDisjoint) {
+    auto It = llvm::upper_bound(TextSections, Address,
+                                [](uint64_t Address, const TextSectionDesc &S) {
+                                  return Address < S.Addr;
+                                });
+    if (It != TextSections.begin() && Address < It[-1].End)
+      return It[-1].Index;
+    return object::SectionedAddress::UndefSection;
   }
 
+  for (const TextSectionDesc &Sec : TextSections)
+    if (Address >= Sec.Addr && Address < Sec.End)
+      return Sec.Index;
+
   return object::SectionedAddress::UndefSection;
 }
@@ -422,6 +422,10 @@ template <typename ELFT> Error ELFLinkGraphBuilder<ELFT>::graphifySymbols() {
   if (!Symbols)
     return Symbols.takeError();
 
+  // Most symbols get a graph symbol; size the index map up front so that
+  // large objects don't rehash it repeatedly.
+  GraphSymbols.reserve(Symbols->size());
+
   // Get the string table for this section.
   auto StringTab = Obj.getStringTableForSymtab(*SymTabSec, Sections);
   if (!StringTab)
@@ -399,8 +399,9 @@ void InProcessMemoryManager::allocate(const JITLinkDylib *JD, LinkGraph &G,
       return;
     }
 
-    // Zero-fill the whole slab up-front.
-    memset(Slab.base(), 0, Slab.allocatedSize());
+    // No need to zero-fill the slab: allocateMappedMemory always hands back a
+    // fresh anonymous mapping, which the OS guarantees to be zeroed. Touching
+    // it here would fault in every zero-fill page of the graph up-front.
 
     StandardSegsMem = {Slab.base(),
                        static_cast<size_t>(SegsSizes->StandardSegs)};
@@ -13,7 +13,6 @@
 #include "llvm/IR/LegacyPassManager.h"
 #include "llvm/IR/Module.h"
 #include "llvm/MC/MCContext.h"
-#include "llvm/Object/ObjectFile.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
@@ -57,11 +56,8 @@ Expected<SimpleCompiler::CompileResult> SimpleCompiler::operator()(Module &M) {
       std::move(ObjBufferSV), M.getModuleIdentifier() + "-jitted-objectbuffer",
       /*RequiresNullTerminator=*/false);
 
-  auto Obj = object::ObjectFile::createObjectFile(ObjBuffer->getMemBufferRef());
-
-  if (!Obj)
-    return Obj.takeError();
-
+  // Don't parse the buffer here just to validate it: the object linking layer
+  // parses it anyway and will report any malformed object.
   notifyObjectCompiled(M, *ObjBuffer);
   return std::move(ObjBuffer);
 }
@@ -1,5 +1,6 @@
 #include "llvm/ExecutionEngine/Orc/ReOptimizeLayer.h"
 #include "llvm/ExecutionEngine/Orc/Mangling.h"
+#include "llvm/Passes/PassBuilder.h"
 
 using namespace llvm;
 using namespace orc;
@@ -113,6 +114,41 @@ Error ReOptimizeLayer::reoptimizeIfCallFrequent(ReOptimizeLayer &Parent,
   });
 }
 
+ReOptimizeLayer::ReOptimizeFunc
+ReOptimizeLayer::runDefaultPipeline(JITTargetMachineBuilder JTMB,
+                                    OptimizationLevel Level) {
+  return [JTMB = std::move(JTMB),
+          Level](ReOptimizeLayer &Parent, ReOptMaterializationUnitID MUID,
+                 unsigned CurVersion, ResourceTrackerSP OldRT,
+                 ThreadSafeModule &TSM) mutable -> Error {
+    // Like ConcurrentIRCompiler, create a TargetMachine per request so that
+    // concurrent reoptimizations do not share one.
+    auto TM = JTMB.createTargetMachine();
+    if (!TM)
+      return TM.takeError();
+
+    // The module is a fresh clone of the one originally added to the layer,
+    // so it does not contain the profiling code of the previous version.
+    TSM.withModuleDo([&](Module &M) {
+      LoopAnalysisManager LAM;
+      FunctionAnalysisManager FAM;
+      CGSCCAnalysisManager CGAM;
+      ModuleAnalysisManager MAM;
+      PassBuilder PB(TM->get());
+      PB.registerModuleAnalyses(MAM);
+      PB.registerCGSCCAnalyses(CGAM);
+      PB.registerFunctionAnalyses(FAM);
+      PB.registerLoopAnalyses(LAM);
+      PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
+      ModulePassManager MPM = Level == OptimizationLevel::O0
+                                  ? PB.buildO0DefaultPipeline(Level)
+                                  : PB.buildPerModuleDefaultPipeline(Level);
+      MPM.run(M, MAM);
+    });
+    return Error::success();
+  };
+}
+
 Expected<SymbolMap>
 ReOptimizeLayer::emitMUImplSymbols(ReOptMaterializationUnitState &MUState,
                                    uint32_t Version, JITDylib &JD,
@@ -28,36 +28,65 @@ SimpleRemoteEPC::loadDylib(const char *DylibPath) {
   return EPCDylibMgr->open(DylibPath, 0);
 }
 
-/// Async helper to chain together calls to DylibMgr::lookupAsync to fulfill all
-/// all the requests.
+/// Issue one DylibMgr::lookupAsync call per request element without waiting
+/// for the previous reply, so that the round-trips overlap, then call Complete
+/// once every element has been answered. Results are kept in request order and
+/// errors from all elements are joined.
 /// FIXME: The dylib manager should support multiple LookupRequests natively.
-static void
-lookupSymbolsAsyncHelper(EPCGenericDylibManager &DylibMgr,
-                         ArrayRef<DylibManager::LookupRequest> Request,
-                         std::vector<tpctypes::LookupResult> Result,
-                         DylibManager::SymbolLookupCompleteFn Complete) {
-  if (Request.empty())
-    return Complete(std::move(Result));
-
-  auto &Element = Request.front();
-  DylibMgr.lookupAsync(Element.Handle, Element.Symbols,
-                       [&DylibMgr, Request, Complete = std::move(Complete),
-                        Result = std::move(Result)](auto R) mutable {
-                         if (!R)
-                           return Complete(R.takeError());
-                         Result.push_back({});
-                         Result.back().reserve(R->size());
-                         llvm::append_range(Result.back(), *R);
-
-                         lookupSymbolsAsyncHelper(
-                             DylibMgr, Request.drop_front(), std::move(Result),
-                             std::move(Complete));
-                       });
-}
-
 void SimpleRemoteEPC::lookupSymbolsAsync(ArrayRef<LookupRequest> Request,
                                          SymbolLookupCompleteFn Complete) {
-  lookupSymbolsAsyncHelper(*EPCDylibMgr, Request, {}, std::move(Complete));
+  if (Request.empty())
+    return Complete(std::vector<tpctypes::LookupResult>());
+
+  struct LookupState {
+    std::mutex M;
+    std::vector<tpctypes::LookupResult> Result;
+    size_t NumPending;
+    Error Err = Error::success();
+    SymbolLookupCompleteFn Complete;
+
+    // If a reply handler is destroyed without being run, the last reference
+    // to the state goes away before NumPending reaches zero. Report that to
+    // the caller rather than dropping Complete and the collected errors.
+    ~LookupState() {
+      if (!Complete) {
+        consumeError(std::move(Err));
+        return;
+      }
+      Complete(joinErrors(
+          std::move(Err),
+          make_error<StringError>("symbol lookup abandoned before all "
+                                  "replies were received",
+                                  inconvertibleErrorCode())));
+    }
+  };
+
+  auto S = std::make_shared<LookupState>();
+  S->Result.resize(Request.size());
+  S->NumPending = Request.size();
+  S->Complete = std::move(Complete);
+
+  for (size_t I = 0; I != Request.size(); ++I) {
+    auto &Element = Request[I];
+    EPCDylibMgr->lookupAsync(Element.Handle, Element.Symbols, [S, I](auto R) {
+      std::unique_lock<std::mutex> Lock(S->M);
+      if (!R)
+        S->Err = joinErrors(std::move(S->Err), R.takeError());
+      else {
+        S->Result[I].reserve(R->size());
+        llvm::append_range(S->Result[I], *R);
+      }
+      if (--S->NumPending)
+        return;
+      auto Complete = std::move(S->Complete);
+      S->Complete = {};
+      Error Err = std::move(S->Err);
+      Lock.unlock();
+      if (Err)
+        return Complete(std::move(Err));
+      Complete(std::move(S->Result));
+    });
+  }
 }
 
 Expected<int32_t> SimpleRemoteEPC::runAsMain(ExecutorAddr MainFnAddr,
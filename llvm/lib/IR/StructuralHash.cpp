@@ -47,11 +47,10 @@ class StructuralHashImpl {
   DenseMap<const Value *, int> ValueToId;
 
   static stable_hash hashType(Type *ValueType) {
-    SmallVector<stable_hash> Hashes;
-    Hashes.emplace_back(ValueType->getTypeID());
+    stable_hash TypeID = ValueType->getTypeID();
     if (ValueType->isIntegerTy())
-      Hashes.emplace_back(ValueType->getIntegerBitWidth());
-    return stable_hash_combine(Hashes);
+      return stable_hash_combine(TypeID, ValueType->getIntegerBitWidth());
+    return stable_hash_combine(TypeID);
   }
 
 public:
@@ -188,23 +187,19 @@ public:
     if (C)
       return hashConstant(C);
 
-    // Hash argument number.
-    SmallVector<stable_hash> Hashes;
-    if (Argument *Arg = dyn_cast<Argument>(V))
-      Hashes.emplace_back(Arg->getArgNo());
-
     // Get an index (an insertion order) for the non-constant value.
     auto [It, WasInserted] = ValueToId.try_emplace(V, ValueToId.size());
-    Hashes.emplace_back(It->second);
+    stable_hash Id = It->second;
 
-    return stable_hash_combine(Hashes);
+    // Hash argument number.
+    if (Argument *Arg = dyn_cast<Argument>(V))
+      return stable_hash_combine(Arg->getArgNo(), Id);
+    return stable_hash_combine(Id);
   }
 
   stable_hash hashOperand(Value *Operand) {
-    SmallVector<stable_hash> Hashes;
-    Hashes.emplace_back(hashType(Operand->getType()));
-    Hashes.emplace_back(hashValue(Operand));
-    return stable_hash_combine(Hashes);
+    return stable_hash_combine(hashType(Operand->getType()),
+                               hashValue(Operand));
   }
 
   stable_hash hashInstruction(const Instruction &Inst) {
@@ -20,6 +20,7 @@
 #include "llvm/Analysis/StackSafetyAnalysis.h"
 #include "llvm/Analysis/TargetLibraryInfo.h"
 #include "llvm/Analysis/TargetTransformInfo.h"
+#include "llvm/BinaryFormat/Magic.h"
 #include "llvm/Bitcode/BitcodeReader.h"
 #include "llvm/Bitcode/BitcodeWriter.h"
 #include "llvm/CGData/CodeGenData.h"
@@ -37,6 +38,7 @@
 #include "llvm/Linker/IRMover.h"
 #include "llvm/MC/TargetRegistry.h"
 #include "llvm/Object/IRObjectFile.h"
+#include "llvm/Object/ObjectFile.h"
 #include "llvm/Support/Caching.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Compiler.h"
@@ -88,6 +90,21 @@ static cl::opt<bool>
     LTOKeepSymbolCopies("lto-keep-symbol-copies", cl::init(false), cl::Hidden,
                         cl::desc("Keep copies of symbols in LTO indexing"));
 
+static cl::opt<unsigned> DTLTODistributorTimeout(
+    "dtlto-distributor-timeout", cl::init(0), cl::Hidden,
+    cl::desc("Seconds to wait for each run of the DTLTO distributor before "
+             "killing it (0 = no limit)"));
+
+static cl::opt<unsigned> DTLTODistributorRetries(
+    "dtlto-distributor-retries", cl::init(0), cl::Hidden,
+    cl::desc("Number of times to re-run the DTLTO distributor for backend "
+             "compilations that did not produce a native object"));
+
+static cl::opt<bool> DTLTOLocalFallback(
+    "dtlto-local-fallback", cl::init(false), cl::Hidden,
+    cl::desc("Run DTLTO backend compilations that the distributor failed to "
+             "complete in-process instead of reporting an error"));
+
 /// Indicate we are linking with an allocator that supports hot/cold operator
 /// new interfaces.
 extern cl::opt<bool> SupportsHotColdNew;
@@ -96,6 +113,16 @@ extern cl::opt<bool> SupportsHotColdNew;
 extern cl::opt<bool> EnableMemProfContextDisambiguation;
 } // namespace llvm
 
+/// Returns the SHA1 of the contents of \p Path, or std::nullopt if it can't
+/// be read.
+static std::optional<std::array<uint8_t, 20>>
+hashFileContents(StringRef Path) {
+  auto FileOrErr = MemoryBuffer::getFile(Path);
+  if (!FileOrErr)
+    return std::nullopt;
+  return SHA1::hash(arrayRefFromStringRef(FileOrErr.get()->getBuffer()));
+}
+
 // Computes a unique hash for the Module considering the current list of
 // export/import and other global analysis results.
 // Returns the hash in its hexadecimal representation.
@@ -334,14 +361,21 @@ std::string llvm::computeLTOCacheKey(
     AddUint64(V);
 
   if (!Conf.SampleProfile.empty()) {
-    auto FileOrErr = MemoryBuffer::getFile(Conf.SampleProfile);
-    if (FileOrErr) {
-      Hasher.update(FileOrErr.get()->getBuffer());
+    // LTO::runThinLTO hashes the profiles once before starting the backends.
+    // Other callers pay for reading them here.
+    std::optional<std::array<uint8_t, 20>> ProfileHash =
+        Conf.SampleProfileHash ? Conf.SampleProfileHash
+                               : hashFileContents(Conf.SampleProfile);
+    if (ProfileHash) {
+      Hasher.update(*ProfileHash);
 
       if (!Conf.ProfileRemapping.empty()) {
-        FileOrErr = MemoryBuffer::getFile(Conf.ProfileRemapping);
-        if (FileOrErr)
-          Hasher.update(FileOrErr.get()->getBuffer());
+        std::optional<std::array<uint8_t, 20>> RemappingHash =
+            Conf.ProfileRemappingHash
+                ? Conf.ProfileRemappingHash
+                : hashFileContents(Conf.ProfileRemapping);
+        if (RemappingHash)
+          Hasher.update(*RemappingHash);
       }
     }
   }
@@ -2046,6 +2080,14 @@ Error LTO::runThinLTO(AddStreamFn AddStream, FileCache Cache,
 
   TimeTraceScopeExit.release();
 
+  // The cache key of every backend includes the sample profile, which can be
+  // hundreds of MB. Hash it here once rather than in each backend thread.
+  if (Cache.isValid() && !Conf.SampleProfile.empty()) {
+    Conf.SampleProfileHash = hashFileContents(Conf.SampleProfile);
+    if (!Conf.ProfileRemapping.empty())
+      Conf.ProfileRemappingHash = hashFileContents(Conf.ProfileRemapping);
+  }
+
   auto &ModuleMap =
       ThinLTO.ModulesToCompile ? *ThinLTO.ModulesToCompile : ThinLTO.ModuleMap;
 
@@ -2224,6 +2266,13 @@ class OutOfProcessThinBackend : public CGThinBackend {
     StringRef NativeObjectPath;
     StringRef SummaryIndexPath;
     ImportsFilesContainer ImportsFiles;
+    // State needed to run the compilation in-process if the distributor fails
+    // to produce NativeObjectPath (see DTLTOLocalFallback).
+    std::optional<BitcodeModule> BM;
+    const FunctionImporter::ImportMapTy *ImportList;
+    MapVector<StringRef, BitcodeModule> *ModuleMap;
+    // The contents of NativeObjectPath, once it holds a valid object file.
+    std::unique_ptr<MemoryBuffer> NativeObject;
   };
   // The set of backend compilations jobs.
   SmallVector<Job> Jobs;
@@ -2281,7 +2330,10 @@ public:
         ModulePath,
         Saver.save(ObjFilePath.str()),
         Saver.save(ObjFilePath.str() + ".thinlto.bc"),
-        {} // Filled in by emitFiles below.
+        {}, // Filled in by emitFiles below.
+        BM,
+        &ImportList,
+        &ModuleMap,
     };
 
     assert(ModuleToDefinedGVSummaries.count(ModulePath));
@@ -2355,9 +2407,9 @@ public:
         Ops.push_back(a);
   }
 
-  // Generates a JSON file describing the backend compilations, for the
-  // distributor.
-  bool emitDistributorJson(StringRef DistributorJson) {
+  // Generates a JSON file describing the backend compilations in \p Pending,
+  // for the distributor.
+  bool emitDistributorJson(StringRef DistributorJson, ArrayRef<Job *> Pending) {
     using json::Array;
     std::error_code EC;
     raw_fd_ostream OS(DistributorJson, EC);
@@ -2386,7 +2438,8 @@ public:
 
       // Per-compilation-job information.
       JOS.attributeArray("jobs", [&]() {
-        for (const auto &J : Jobs) {
+        for (const Job *JP : Pending) {
+          const Job &J = *JP;
           assert(J.Task != 0);
 
           SmallVector<StringRef, 2> Inputs;
@@ -2428,6 +2481,28 @@ public:
              << "': " << EC.message() << "\n";
   }
 
+  // Loads the native object of \p J if it is a complete object file. A
+  // distributor that is killed on timeout can leave a truncated one behind,
+  // which must not be linked.
+  static bool loadNativeObject(Job &J) {
+    ErrorOr<std::unique_ptr<MemoryBuffer>> MBOrErr =
+        MemoryBuffer::getFile(J.NativeObjectPath, /*IsText=*/false,
+                              /*RequiresNullTerminator=*/false);
+    if (!MBOrErr)
+      return false;
+    MemoryBufferRef MBRef = (*MBOrErr)->getMemBufferRef();
+    if (identify_magic(MBRef.getBuffer()) == file_magic::unknown)
+      return false;
+    Expected<std::unique_ptr<object::ObjectFile>> ObjOrErr =
+        object::ObjectFile::createObjectFile(MBRef);
+    if (!ObjOrErr) {
+      consumeError(ObjOrErr.takeError());
+      return false;
+    }
+    J.NativeObject = std::move(*MBOrErr);
+    return true;
+  }
+
   Error wait() override {
     // Wait for the information on the required backend compilations to be
     // gathered.
@@ -2451,10 +2526,6 @@ public:
     SString JsonFile = sys::path::parent_path(LinkerOutputFile);
     sys::path::append(JsonFile, sys::path::stem(LinkerOutputFile) + "." + UID +
                                     ".dist-file.json");
-    if (!emitDistributorJson(JsonFile))
-      return make_error<StringError>(
-          BCError + "failed to generate distributor JSON script: " + JsonFile,
-          inconvertibleErrorCode());
     auto CleanJson = llvm::make_scope_exit([&] {
       if (!SaveTemps)
         removeFile(JsonFile);
@@ -2463,32 +2534,97 @@ public:
     SmallVector<StringRef, 3> Args = {DistributorPath};
     llvm::append_range(Args, DistributorArgs);
     Args.push_back(JsonFile);
-    std::string ErrMsg;
-    if (sys::ExecuteAndWait(Args[0], Args,
-                            /*Env=*/std::nullopt, /*Redirects=*/{},
-                            /*SecondsToWait=*/0, /*MemoryLimit=*/0, &ErrMsg)) {
+
+    // Run the distributor over the jobs that have not produced a native object
+    // yet. Jobs that are still outstanding after the last permitted attempt
+    // are either compiled in-process or reported as errors below.
+    SmallVector<Job *, 0> Pending;
+    for (auto &Job : Jobs)
+      Pending.push_back(&Job);
+    // The failures of all attempts, in order, as a later attempt can fail for
+    // a different reason than the one that left the jobs outstanding.
+    std::string DistributorErrors;
+    bool LastAttemptFailed = false;
+    for (unsigned Attempt = 0;; ++Attempt) {
+      // Do not mistake an output left behind by an earlier attempt, or by an
+      // earlier link, for the result of this one.
+      for (const Job *J : Pending)
+        removeFile(J->NativeObjectPath);
+      if (!emitDistributorJson(JsonFile, Pending))
+        return make_error<StringError>(
+            BCError + "failed to generate distributor JSON script: " + JsonFile,
+            inconvertibleErrorCode());
+
+      std::string ErrMsg;
+      int RC = sys::ExecuteAndWait(Args[0], Args,
+                                   /*Env=*/std::nullopt, /*Redirects=*/{},
+                                   DTLTODistributorTimeout, /*MemoryLimit=*/0,
+                                   &ErrMsg);
+      LastAttemptFailed = RC != 0;
+      if (LastAttemptFailed) {
+        if (ErrMsg.empty())
+          ErrMsg = "exited with code " + std::to_string(RC);
+        DistributorErrors += (Twine(DistributorErrors.empty() ? "" : "; ") +
+                              "attempt " + Twine(Attempt + 1) + ": " + ErrMsg)
+                                 .str();
+      }
+
+      llvm::erase_if(Pending, [](Job *J) { return loadNativeObject(*J); });
+      if (Pending.empty() || Attempt == DTLTODistributorRetries)
+        break;
+    }
+
+    if ((LastAttemptFailed || !Pending.empty()) &&
+        !DistributorErrors.empty() && !DTLTOLocalFallback)
       return make_error<StringError>(
-          BCError + "distributor execution failed" +
-              (!ErrMsg.empty() ? ": " + ErrMsg + Twine(".") : Twine(".")),
+          BCError + "distributor execution failed: " + DistributorErrors + ".",
           inconvertibleErrorCode());
+
+    DenseSet<const Job *> LocalJobs;
+    if (DTLTOLocalFallback && !Pending.empty()) {
+      for (Job *J : Pending) {
+        LocalJobs.insert(J);
+        BackendThreadPool.async([this, J] {
+          LTOLLVMContext BackendContext(Conf);
+          const GVSummaryMapTy &DefinedGlobals =
+              ModuleToDefinedGVSummaries.find(J->ModuleID)->second;
+          Error E = [&]() -> Error {
+            Expected<std::unique_ptr<Module>> MOrErr =
+                J->BM->parseModule(BackendContext);
+            if (!MOrErr)
+              return MOrErr.takeError();
+            return thinBackend(Conf, J->Task, AddStream, **MOrErr,
+                               CombinedIndex, *J->ImportList, DefinedGlobals,
+                               J->ModuleMap, Conf.CodeGenOnly);
+          }();
+          if (E) {
+            std::unique_lock<std::mutex> L(ErrMu);
+            if (Err)
+              Err = joinErrors(std::move(*Err), std::move(E));
+            else
+              Err = std::move(E);
+          }
+        });
+      }
+      BackendThreadPool.wait();
+      if (Err)
+        return std::move(*Err);
     }
 
     for (auto &Job : Jobs) {
-      // Load the native object from a file into a memory buffer
-      // and store its contents in the output buffer.
-      auto ObjFileMbOrErr =
-          MemoryBuffer::getFile(Job.NativeObjectPath, /*IsText=*/false,
-                                /*RequiresNullTerminator=*/false);
-      if (std::error_code EC = ObjFileMbOrErr.getError())
+      if (LocalJobs.count(&Job))
+        continue;
+      // Store the contents of the native object in the output buffer.
+      if (!Job.NativeObject)
         return make_error<StringError>(
-            BCError + "cannot open native object file: " +
-                Job.NativeObjectPath + ": " + EC.message(),
+            BCError + "missing or invalid native object file: " +
+                Job.NativeObjectPath,
             inconvertibleErrorCode());
       auto StreamOrErr = AddStream(Job.Task, Job.ModuleID);
       if (Error Err = StreamOrErr.takeError())
         report_fatal_error(std::move(Err));
       auto &Stream = *StreamOrErr->get();
-      *Stream.OS << ObjFileMbOrErr->get()->getMemBufferRef().getBuffer();
+      *Stream.OS << Job.NativeObject->getBuffer();
       if (Error Err = Stream.commit())
         report_fatal_error(std::move(Err));
     }
@@ -1132,10 +1132,17 @@ unsigned MCAssembler::relaxOnce(unsigned FirstStable) {
     auto &Sec = *Sections[I];
     auto MaxIter = Sec.curFragList()->Tail->getLayoutOrder() + 1;
     for (;;) {
+      // The earliest fragment whose offset or size may be stale after this
+      // walk. An org's size depends on the value of its target expression,
+      // which may refer to labels later in the section.
+      MCFragment *FirstChanged = nullptr;
       bool Changed = false;
-      for (MCFragment &F : Sec)
-        if (relaxFragment(F))
-          Changed = true;
+      for (MCFragment &F : Sec) {
+        bool FragChanged = relaxFragment(F);
+        Changed |= FragChanged;
+        if (!FirstChanged && (FragChanged || F.getKind() == MCFragment::FT_Org))
+          FirstChanged = &F;
+      }
 
       if (!Changed)
         break;
@@ -1145,7 +1152,18 @@ unsigned MCAssembler::relaxOnce(unsigned FirstStable) {
       Res = I;
       if (--MaxIter == 0)
         break;
-      layoutSection(Sec);
+      // Fragments before FirstChanged keep their offsets and sizes, so only
+      // the tail of the section needs to be laid out again. Bundle
+      // padding depends on the previous fragment; use the full layout then.
+      if (LLVM_UNLIKELY(isBundlingEnabled())) {
+        layoutSection(Sec);
+        continue;
+      }
+      uint64_t Offset = FirstChanged->Offset;
+      for (MCFragment *F = FirstChanged; F; F = F->getNext()) {
+        F->Offset = Offset;
+        Offset += computeFragmentSize(*F);
+      }
     }
   }
   // The subsequent relaxOnce call only needs to visit Sections [0,Res) if no
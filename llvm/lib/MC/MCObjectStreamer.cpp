@@ -380,17 +380,18 @@ void MCObjectStreamer::emitInstructionImpl(const MCInst &Inst,
 void MCObjectStreamer::emitInstToData(const MCInst &Inst,
                                       const MCSubtargetInfo &STI) {
   MCDataFragment *DF = getOrCreateDataFragment();
+  // Encode directly into the fragment rather than through a temporary buffer.
+  auto CodeOffset = DF->getContents().size();
   SmallVector<MCFixup, 1> Fixups;
-  SmallString<256> Code;
-  getAssembler().getEmitter().encodeInstruction(Inst, Code, Fixups, STI);
+  getAssembler().getEmitter().encodeInstruction(
+      Inst, DF->getContentsForAppending(), Fixups, STI);
+  DF->doneAppending();
 
-  auto CodeOffset = DF->getContents().size();
   for (MCFixup &Fixup : Fixups)
     Fixup.setOffset(Fixup.getOffset() + CodeOffset);
   if (!Fixups.empty())
     DF->appendFixups(Fixups);
   DF->setHasInstructions(STI);
-  DF->appendContents(Code);
 }
 
 void MCObjectStreamer::emitInstToFragment(const MCInst &Inst,
@@ -837,33 +837,15 @@ Error CoverageMapping::loadFunctionRecord(
 
   CounterMappingContext Ctx(Record.Expressions);
 
-  std::vector<uint64_t> Counts;
-  if (ProfileReader) {
-    if (Error E = ProfileReader.value().get().getFunctionCounts(
-            Record.FunctionName, Record.FunctionHash, Counts)) {
-      instrprof_error IPE = std::get<0>(InstrProfError::take(std::move(E)));
-      if (IPE == instrprof_error::hash_mismatch) {
-        FuncHashMismatches.emplace_back(std::string(Record.FunctionName),
-                                        Record.FunctionHash);
-        return Error::success();
-      }
-      if (IPE != instrprof_error::unknown_function)
-        return make_error<InstrProfError>(IPE);
-      Counts.assign(getMaxCounterID(Ctx, Record) + 1, 0);
-    }
-  } else {
-    Counts.assign(getMaxCounterID(Ctx, Record) + 1, 0);
-  }
-  Ctx.setCounts(Counts);
-
   bool IsVersion11 =
       ProfileReader && ProfileReader.value().get().getVersion() <
                            IndexedInstrProf::ProfVersion::Version12;
 
+  std::vector<uint64_t> Counts;
   BitVector Bitmap;
   if (ProfileReader) {
-    if (Error E = ProfileReader.value().get().getFunctionBitmap(
-            Record.FunctionName, Record.FunctionHash, Bitmap)) {
+    if (Error E = ProfileReader.value().get().getFunctionCountsAndBitmap(
+            Record.FunctionName, Record.FunctionHash, Counts, Bitmap)) {
       instrprof_error IPE = std::get<0>(InstrProfError::take(std::move(E)));
       if (IPE == instrprof_error::hash_mismatch) {
         FuncHashMismatches.emplace_back(std::string(Record.FunctionName),
@@ -872,11 +854,14 @@ Error CoverageMapping::loadFunctionRecord(
       }
       if (IPE != instrprof_error::unknown_function)
         return make_error<InstrProfError>(IPE);
+      Counts.assign(getMaxCounterID(Ctx, Record) + 1, 0);
       Bitmap = BitVector(getMaxBitmapSize(Record, IsVersion11));
     }
   } else {
+    Counts.assign(getMaxCounterID(Ctx, Record) + 1, 0);
     Bitmap = BitVector(getMaxBitmapSize(Record, false));
   }
+  Ctx.setCounts(Counts);
   Ctx.setBitmap(std::move(Bitmap));
 
   assert(!Record.MappingRegions.empty() && "Function has no regions");
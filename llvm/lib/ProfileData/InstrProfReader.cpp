@@ -1002,7 +1002,7 @@ data_type InstrProfLookupTrait::ReadData(StringRef K, const unsigned char *D,
 
 template <typename HashTableImpl>
 Error InstrProfReaderIndex<HashTableImpl>::getRecords(
-    StringRef FuncName, ArrayRef<NamedInstrProfRecord> &Data) {
+    StringRef FuncName, MutableArrayRef<NamedInstrProfRecord> &Data) {
   auto Iter = HashTable->find(FuncName);
   if (Iter == HashTable->end())
     return make_error<InstrProfError>(instrprof_error::unknown_function);
@@ -1057,7 +1057,7 @@ public:
       : Underlying(Underlying) {}
 
   Error getRecords(StringRef FuncName,
-                   ArrayRef<NamedInstrProfRecord> &Data) override {
+                   MutableArrayRef<NamedInstrProfRecord> &Data) override {
     return Underlying.getRecords(FuncName, Data);
   }
 };
@@ -1117,7 +1117,7 @@ public:
   }
 
   Error getRecords(StringRef FuncName,
-                   ArrayRef<NamedInstrProfRecord> &Data) override {
+                   MutableArrayRef<NamedInstrProfRecord> &Data) override {
     StringRef RealName = extractName(FuncName);
     if (auto Key = Remappings.lookup(RealName)) {
       StringRef Remapped = MappedNames.lookup(Key);
@@ -1372,7 +1372,7 @@ InstrProfSymtab &IndexedInstrProfReader::getSymtab() {
 Expected<NamedInstrProfRecord> IndexedInstrProfReader::getInstrProfRecord(
     StringRef FuncName, uint64_t FuncHash, StringRef DeprecatedFuncName,
     uint64_t *MismatchedFuncSum) {
-  ArrayRef<NamedInstrProfRecord> Data;
+  MutableArrayRef<NamedInstrProfRecord> Data;
   uint64_t FuncSum = 0;
   auto Err = Remapper->getRecords(FuncName, Data);
   if (Err) {
@@ -1407,8 +1407,10 @@ Expected<NamedInstrProfRecord> IndexedInstrProfReader::getInstrProfRecord(
     return ValueSum;
   };
 
-  for (const NamedInstrProfRecord &I : Data) {
-    // Check for a match and fill the vector if there is one.
+  for (NamedInstrProfRecord &I : Data) {
+    // Check for a match and fill the vector if there is one. The records are
+    // decoded afresh on every lookup, so move the match out rather than
+    // deep-copying its counters and value profile data.
     if (I.Hash == FuncHash)
       return std::move(I);
     if (NamedInstrProfRecord::hasCSFlagInHash(I.Hash) ==
@@ -1576,18 +1578,12 @@ Error IndexedInstrProfReader::getFunctionCounts(StringRef FuncName,
   if (Error E = Record.takeError())
     return error(std::move(E));
 
-  Counts = Record.get().Counts;
+  Counts = std::move(Record.get().Counts);
   return success();
 }
 
-Error IndexedInstrProfReader::getFunctionBitmap(StringRef FuncName,
-                                                uint64_t FuncHash,
-                                                BitVector &Bitmap) {
-  auto Record = getInstrProfRecord(FuncName, FuncHash);
-  if (Error E = Record.takeError())
-    return error(std::move(E));
-
-  const auto &BitmapBytes = Record.get().BitmapBytes;
+static void fillBitmapFromBytes(ArrayRef<uint8_t> BitmapBytes,
+                                BitVector &Bitmap) {
   size_t I = 0, E = BitmapBytes.size();
   Bitmap.resize(E * CHAR_BIT);
   BitVector::apply(
@@ -1603,7 +1599,28 @@ Error IndexedInstrProfReader::getFunctionBitmap(StringRef FuncName,
       },
       Bitmap, Bitmap);
   assert(I == E);
+}
+
+Error IndexedInstrProfReader::getFunctionBitmap(StringRef FuncName,
+                                                uint64_t FuncHash,
+                                                BitVector &Bitmap) {
+  auto Record = getInstrProfRecord(FuncName, FuncHash);
+  if (Error E = Record.takeError())
+    return error(std::move(E));
+
+  fillBitmapFromBytes(Record.get().BitmapBytes, Bitmap);
+  return success();
+}
+
+Error IndexedInstrProfReader::getFunctionCountsAndBitmap(
+    StringRef FuncName, uint64_t FuncHash, std::vector<uint64_t> &Counts,
+    BitVector &Bitmap) {
+  auto Record = getInstrProfRecord(FuncName, FuncHash);
+  if (Error E = Record.takeError())
+    return error(std::move(E));
 
+  Counts = std::move(Record.get().Counts);
+  fillBitmapFromBytes(Record.get().BitmapBytes, Bitmap);
   return success();
 }
 
@@ -390,9 +390,16 @@ void InstrProfWriter::addTemporalProfileTraces(
 
 void InstrProfWriter::mergeRecordsFromWriter(InstrProfWriter &&IPW,
                                              function_ref<void(Error)> Warn) {
-  for (auto &I : IPW.FunctionData)
+  // Release each function's records as soon as they have been merged: records
+  // that were merged into an existing entry still own their counters and value
+  // data, and IPW is being consumed anyway. This keeps the peak memory of
+  // combining two writers close to the size of the destination.
+  for (auto &I : IPW.FunctionData) {
     for (auto &Func : I.getValue())
       addRecord(I.getKey(), Func.first, std::move(Func.second), 1, Warn);
+    I.getValue().clear();
+  }
+  IPW.FunctionData.clear();
 
   BinaryIds.reserve(BinaryIds.size() + IPW.BinaryIds.size());
   for (auto &I : IPW.BinaryIds)
@@ -38,12 +38,17 @@ Error RemarkStreamer::setFilter(StringRef Filter) {
     return createStringError(std::make_error_code(std::errc::invalid_argument),
                              RegexError.data());
   PassFilter = std::move(R);
+  PassFilterCache.clear();
   return Error::success();
 }
 
 bool RemarkStreamer::matchesFilter(StringRef Str) {
-  if (PassFilter)
-    return PassFilter->match(Str);
+  if (PassFilter) {
+    auto [It, Inserted] = PassFilterCache.try_emplace(Str);
+    if (Inserted)
+      It->second = PassFilter->match(Str);
+    return It->second;
+  }
   // No filter means all strings pass.
   return true;
 }
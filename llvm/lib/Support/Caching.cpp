@@ -9,6 +9,8 @@
 // This file implements the localCache function, which simplifies creating,
 // adding to, and querying a local file system cache. localCache takes care of
 // periodically pruning older files from the cache using a CachePruningPolicy.
+// It also implements a directory based CacheStore and the tieredCache
+// function, which layers a CacheStore below a FileCache.
 //
 //===----------------------------------------------------------------------===//
 
@@ -17,6 +19,8 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/WithColor.h"
+#include <atomic>
 
 #if !defined(_MSC_VER) && !defined(__MINGW32__)
 #include <unistd.h>
@@ -174,3 +178,168 @@ Expected<FileCache> llvm::localCache(const Twine &CacheNameRef,
   };
   return FileCache(Func, CacheDirectoryPathRef.str());
 }
+
+CacheStore::~CacheStore() = default;
+
+namespace {
+class DirectoryCacheStore : public CacheStore {
+  SmallString<64> DirectoryPath;
+
+  SmallString<64> getEntryPath(StringRef Key) const {
+    SmallString<64> EntryPath;
+    sys::path::append(EntryPath, DirectoryPath, "llvmcache-" + Key);
+    return EntryPath;
+  }
+
+public:
+  DirectoryCacheStore(const Twine &Path) { Path.toVector(DirectoryPath); }
+
+  Expected<std::unique_ptr<MemoryBuffer>> get(StringRef Key) override {
+    SmallString<64> EntryPath = getEntryPath(Key);
+    ErrorOr<std::unique_ptr<MemoryBuffer>> MBOrErr =
+        MemoryBuffer::getFile(EntryPath, /*IsText=*/false,
+                              /*RequiresNullTerminator=*/false);
+    if (MBOrErr)
+      return std::move(*MBOrErr);
+    std::error_code EC = MBOrErr.getError();
+    if (EC == errc::no_such_file_or_directory || EC == errc::permission_denied)
+      return nullptr;
+    return createStringError(EC, Twine("Failed to open cache file ") +
+                                     EntryPath + ": " + EC.message());
+  }
+
+  Error put(StringRef Key, StringRef Data) override {
+    if (std::error_code EC = sys::fs::create_directories(
+            DirectoryPath, /*IgnoreExisting=*/true))
+      return createStringError(EC, Twine("can't create cache directory ") +
+                                       DirectoryPath + ": " + EC.message());
+
+    // Write to a temporary file and rename it into place so that concurrent
+    // readers never observe a partially written entry.
+    SmallString<64> TempFilenameModel;
+    sys::path::append(TempFilenameModel, DirectoryPath,
+                      "llvmcache-store-%%%%%%.tmp");
+    Expected<sys::fs::TempFile> Temp = sys::fs::TempFile::create(
+        TempFilenameModel, sys::fs::owner_read | sys::fs::owner_write);
+    if (!Temp)
+      return Temp.takeError();
+    {
+      raw_fd_ostream OS(Temp->FD, /*shouldClose=*/false);
+      OS << Data;
+    }
+    return Temp->keep(getEntryPath(Key));
+  }
+};
+} // namespace
+
+std::unique_ptr<CacheStore>
+llvm::createDirectoryCacheStore(const Twine &DirectoryPath) {
+  return std::make_unique<DirectoryCacheStore>(DirectoryPath);
+}
+
+namespace {
+/// State shared by all lookups of one tiered cache. Once the remote store has
+/// failed, it is no longer consulted and the cache behaves like the local one.
+struct RemoteState {
+  std::shared_ptr<CacheStore> Store;
+  std::function<void(Error)> Warn;
+  std::atomic<bool> Failed{false};
+
+  RemoteState(std::shared_ptr<CacheStore> Store,
+              std::function<void(Error)> Warn)
+      : Store(std::move(Store)), Warn(std::move(Warn)) {}
+
+  void fail(Error E) {
+    if (Failed.exchange(true)) {
+      consumeError(std::move(E));
+      return;
+    }
+    Warn(createStringError(inconvertibleErrorCode(),
+                           "shared cache unavailable, continuing with the "
+                           "local cache only: " +
+                               toString(std::move(E))));
+  }
+};
+} // namespace
+
+FileCache llvm::tieredCache(FileCache Local,
+                            std::shared_ptr<CacheStore> Remote,
+                            std::function<void(Error)> Warn) {
+  if (!Warn)
+    Warn = WithColor::defaultWarningHandler;
+  auto State =
+      std::make_shared<RemoteState>(std::move(Remote), std::move(Warn));
+  std::string DirectoryPath = Local.getCacheDirectoryPath();
+  auto Func = [=](unsigned Task, StringRef Key,
+                  const Twine &ModuleName) mutable -> Expected<AddStreamFn> {
+    Expected<AddStreamFn> AddStreamOrErr = Local(Task, Key, ModuleName);
+    if (!AddStreamOrErr || !*AddStreamOrErr || State->Failed)
+      return AddStreamOrErr;
+    AddStreamFn AddLocalStream = std::move(*AddStreamOrErr);
+
+    // Local miss. If the remote store has the entry, populate the local cache
+    // with it; committing the stream adds the entry to the link.
+    Expected<std::unique_ptr<MemoryBuffer>> MBOrErr = State->Store->get(Key);
+    if (!MBOrErr) {
+      State->fail(MBOrErr.takeError());
+      return AddLocalStream;
+    }
+    if (*MBOrErr) {
+      Expected<std::unique_ptr<CachedFileStream>> StreamOrErr =
+          AddLocalStream(Task, ModuleName);
+      if (!StreamOrErr)
+        return StreamOrErr.takeError();
+      *(*StreamOrErr)->OS << (*MBOrErr)->getBuffer();
+      if (Error E = (*StreamOrErr)->commit())
+        return std::move(E);
+      return AddStreamFn();
+    }
+
+    // Miss in both levels. Upload the entry once it is committed locally.
+    struct UploadStream : CachedFileStream {
+      std::unique_ptr<CachedFileStream> LocalStream;
+      std::shared_ptr<RemoteState> State;
+      std::string Key;
+
+      UploadStream(std::unique_ptr<CachedFileStream> LocalStream,
+                   std::shared_ptr<RemoteState> State, std::string Key)
+          : CachedFileStream(std::move(LocalStream->OS),
+                             LocalStream->ObjectPathName),
+            LocalStream(std::move(LocalStream)), State(std::move(State)),
+            Key(std::move(Key)) {}
+
+      Error commit() override {
+        if (Error E = CachedFileStream::commit())
+          return E;
+        // Flush the stream before the local cache takes over the file.
+        OS.reset();
+        if (Error E = LocalStream->commit())
+          return E;
+        if (State->Failed)
+          return Error::success();
+        // The entry may already have been pruned from the local cache, in
+        // which case there is nothing to upload.
+        ErrorOr<std::unique_ptr<MemoryBuffer>> MBOrErr =
+            MemoryBuffer::getFile(ObjectPathName, /*IsText=*/false,
+                                  /*RequiresNullTerminator=*/false);
+        if (!MBOrErr)
+          return Error::success();
+        if (Error E = State->Store->put(Key, (*MBOrErr)->getBuffer()))
+          State->fail(std::move(E));
+        return Error::success();
+      }
+    };
+
+    std::string KeyStr = Key.str();
+    return [=](size_t Task, const Twine &ModuleName)
+               -> Expected<std::unique_ptr<CachedFileStream>> {
+      Expected<std::unique_ptr<CachedFileStream>> StreamOrErr =
+          AddLocalStream(Task, ModuleName);
+      if (!StreamOrErr)
+        return StreamOrErr.takeError();
+      return std::make_unique<UploadStream>(std::move(*StreamOrErr), State,
+                                            KeyStr);
+    };
+  };
+  return FileCache(Func, DirectoryPath);
+}
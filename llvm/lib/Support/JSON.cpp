@@ -543,7 +543,11 @@ bool Parser::parseString(std::string &Out) {
     if (LLVM_UNLIKELY((C & 0x1f) == C))
       return parseError("Control character in string");
     if (LLVM_LIKELY(C != '\\')) {
-      Out.push_back(C);
+      // Copy the whole run of plain characters at once.
+      const char *Start = P - 1;
+      while (P != End && *P != '"' && *P != '\\' && (*P & 0x1f) != *P)
+        ++P;
+      Out.append(Start, P);
       continue;
     }
     // Handle escape sequence.
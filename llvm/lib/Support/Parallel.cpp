@@ -7,12 +7,16 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Support/Parallel.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/Config/llvm-config.h"
 #include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/Threading.h"
 
+#include <algorithm>
 #include <atomic>
+#include <deque>
 #include <future>
+#include <list>
 #include <thread>
 #include <vector>
 
@@ -38,18 +42,34 @@ namespace {
 class Executor {
 public:
   virtual ~Executor() = default;
-  virtual void add(std::function<void()> func) = 0;
+  /// Queue \p func. \p Group identifies the TaskGroup that spawned it, if
+  /// any, so that a thread waiting for that group can run it.
+  virtual void add(std::function<void()> func,
+                   const void *Group = nullptr) = 0;
   virtual size_t getThreadCount() const = 0;
 
+  /// Run one queued task of \p Group on the calling worker thread, if there is
+  /// any. Returns false if no task of \p Group was queued.
+  virtual bool runPendingTask(const void *Group) = 0;
+
+  virtual std::vector<WorkerStats> getWorkerStats() const = 0;
+
   static Executor *getDefaultExecutor();
 };
 
-/// An implementation of an Executor that runs closures on a thread pool
-///   in filo order.
+/// An implementation of an Executor that runs closures on a thread pool.
+///
+/// Every worker owns a task queue. Tasks spawned from a worker are pushed to
+/// and popped from the back of its own queue (filo order), while idle workers
+/// steal from the front of the queues of other workers. Tasks added from
+/// threads outside of the pool go to a shared stack. A worker that waits for
+/// a nested TaskGroup runs the queued tasks of that group (see
+/// runPendingTask()), so nested parallel loops fan out over the whole pool
+/// without deadlocking.
 class ThreadPoolExecutor : public Executor {
 public:
-  explicit ThreadPoolExecutor(ThreadPoolStrategy S) {
-    ThreadCount = S.compute_thread_count();
+  explicit ThreadPoolExecutor(ThreadPoolStrategy S)
+      : ThreadCount(S.compute_thread_count()), Queues(ThreadCount) {
     // Spawn all but one of the threads in another thread as spawning threads
     // can take a while.
     Threads.reserve(ThreadCount);
@@ -97,39 +117,192 @@ public:
     static void call(void *Ptr) { ((ThreadPoolExecutor *)Ptr)->stop(); }
   };
 
-  void add(std::function<void()> F) override {
-    {
-      std::lock_guard<std::mutex> Lock(Mutex);
-      WorkStack.push_back(std::move(F));
+  void add(std::function<void()> F, const void *Group) override {
+    // PendingTasks is updated under the lock of the queue holding the task,
+    // so that it never counts a task that was already taken.
+    if (threadIndex < ThreadCount) {
+      WorkerQueue &Q = Queues[threadIndex];
+      std::lock_guard<std::mutex> Lock(Q.Mutex);
+      Q.Tasks.push(std::move(F), Group);
+      PendingTasks.fetch_add(1, std::memory_order_release);
+    } else {
+      std::lock_guard<std::mutex> Lock(SharedMutex);
+      WorkStack.push(std::move(F), Group);
+      PendingTasks.fetch_add(1, std::memory_order_release);
     }
+    // Take the mutex so that a worker that has just seen no pending tasks
+    // cannot miss the notification.
+    { std::lock_guard<std::mutex> Lock(Mutex); }
     Cond.notify_one();
   }
 
   size_t getThreadCount() const override { return ThreadCount; }
 
+  bool runPendingTask(const void *Group) override {
+    assert(threadIndex < ThreadCount && "not called from a worker thread");
+    std::function<void()> Task;
+    if (!takeTask(threadIndex, Task, Group))
+      return false;
+    runTakenTask(threadIndex, Task);
+    return true;
+  }
+
+  std::vector<WorkerStats> getWorkerStats() const override {
+    std::vector<WorkerStats> Stats(ThreadCount);
+    for (unsigned I = 0; I < ThreadCount; ++I) {
+      Stats[I].TasksRun = Queues[I].TasksRun.load(std::memory_order_relaxed);
+      Stats[I].Steals = Queues[I].Steals.load(std::memory_order_relaxed);
+      Stats[I].IdleWaits = Queues[I].IdleWaits.load(std::memory_order_relaxed);
+    }
+    return Stats;
+  }
+
 private:
+  /// Queued tasks in push order. The tasks of each group are also indexed
+  /// separately, so that taking the first or last task of a group does not
+  /// scan or shift the tasks of other groups.
+  class TaskQueue {
+  public:
+    bool empty() const { return Tasks.empty(); }
+
+    void push(std::function<void()> F, const void *Group) {
+      Tasks.push_back({std::move(F), Group});
+      ByGroup[Group].push_back(std::prev(Tasks.end()));
+    }
+
+    /// Take the most recently pushed task of \p Group, or of any group if
+    /// \p Group is null.
+    bool takeBack(std::function<void()> &F, const void *Group = nullptr) {
+      return take(F, Group ? Group : lastGroup(), /*Back=*/true);
+    }
+
+    /// Take the oldest task of \p Group, or of any group if \p Group is null.
+    bool takeFront(std::function<void()> &F, const void *Group = nullptr) {
+      return take(F, Group ? Group : firstGroup(), /*Back=*/false);
+    }
+
+  private:
+    struct QueuedTask {
+      std::function<void()> F;
+      const void *Group;
+    };
+    using TaskIt = std::list<QueuedTask>::iterator;
+
+    const void *firstGroup() const {
+      return Tasks.empty() ? nullptr : Tasks.front().Group;
+    }
+    const void *lastGroup() const {
+      return Tasks.empty() ? nullptr : Tasks.back().Group;
+    }
+
+    // Within a group, tasks are in push order in both lists, so the first and
+    // last tasks of the whole queue are also the first and last of their
+    // group.
+    bool take(std::function<void()> &F, const void *Group, bool Back) {
+      auto GroupIt = ByGroup.find(Group);
+      if (GroupIt == ByGroup.end())
+        return false;
+      std::deque<TaskIt> &GroupTasks = GroupIt->second;
+      TaskIt It = Back ? GroupTasks.back() : GroupTasks.front();
+      if (Back)
+        GroupTasks.pop_back();
+      else
+        GroupTasks.pop_front();
+      if (GroupTasks.empty())
+        ByGroup.erase(GroupIt);
+      F = std::move(It->F);
+      Tasks.erase(It);
+      return true;
+    }
+
+    std::list<QueuedTask> Tasks;
+    DenseMap<const void *, std::deque<TaskIt>> ByGroup;
+  };
+
+  struct WorkerQueue {
+    std::mutex Mutex;
+    TaskQueue Tasks;
+    std::atomic<uint64_t> TasksRun{0};
+    std::atomic<uint64_t> Steals{0};
+    std::atomic<uint64_t> IdleWaits{0};
+  };
+
+  // Take the most recently pushed task of worker \p ThreadID, then the most
+  // recently added external task, and finally the oldest task of any other
+  // worker. A null \p Group takes tasks of any group; otherwise only tasks of
+  // \p Group are taken. Tasks spawned into a group from other workers, such
+  // as the recursive spawns of parallelSort, end up in their queues.
+  //
+  // PendingTasks is decremented under the lock that removes the task, so that
+  // idle workers never wake up for a task that was already taken.
+  bool takeTask(unsigned ThreadID, std::function<void()> &Task,
+                const void *Group = nullptr) {
+    if (PendingTasks.load(std::memory_order_acquire) == 0)
+      return false;
+    {
+      WorkerQueue &Q = Queues[ThreadID];
+      std::lock_guard<std::mutex> Lock(Q.Mutex);
+      if (Q.Tasks.takeBack(Task, Group)) {
+        PendingTasks.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+    {
+      std::lock_guard<std::mutex> Lock(SharedMutex);
+      if (WorkStack.takeBack(Task, Group)) {
+        PendingTasks.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+    for (unsigned I = 1; I < ThreadCount; ++I) {
+      WorkerQueue &Victim = Queues[(ThreadID + I) % ThreadCount];
+      std::lock_guard<std::mutex> Lock(Victim.Mutex);
+      if (Victim.Tasks.takeFront(Task, Group)) {
+        PendingTasks.fetch_sub(1, std::memory_order_relaxed);
+        Queues[ThreadID].Steals.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void runTakenTask(unsigned ThreadID, std::function<void()> &Task) {
+    Queues[ThreadID].TasksRun.fetch_add(1, std::memory_order_relaxed);
+    Task();
+  }
+
+  bool runTask(unsigned ThreadID) {
+    std::function<void()> Task;
+    if (!takeTask(ThreadID, Task))
+      return false;
+    runTakenTask(ThreadID, Task);
+    return true;
+  }
+
   void work(ThreadPoolStrategy S, unsigned ThreadID) {
     threadIndex = ThreadID;
     S.apply_thread_strategy(ThreadID);
-    while (true) {
+    while (!Stop) {
+      if (runTask(ThreadID))
+        continue;
       std::unique_lock<std::mutex> Lock(Mutex);
-      Cond.wait(Lock, [&] { return Stop || !WorkStack.empty(); });
-      if (Stop)
-        break;
-      auto Task = std::move(WorkStack.back());
-      WorkStack.pop_back();
-      Lock.unlock();
-      Task();
+      Queues[ThreadID].IdleWaits.fetch_add(1, std::memory_order_relaxed);
+      Cond.wait(Lock, [&] {
+        return Stop || PendingTasks.load(std::memory_order_acquire) != 0;
+      });
     }
   }
 
   std::atomic<bool> Stop{false};
-  std::vector<std::function<void()>> WorkStack;
+  std::atomic<size_t> PendingTasks{0};
+  std::mutex SharedMutex;
+  TaskQueue WorkStack;
   std::mutex Mutex;
   std::condition_variable Cond;
   std::promise<void> ThreadsCreated;
   std::vector<std::thread> Threads;
   unsigned ThreadCount;
+  std::vector<WorkerQueue> Queues;
 };
 
 Executor *Executor::getDefaultExecutor() {
@@ -172,22 +345,39 @@ Executor *Executor::getDefaultExecutor() {
 size_t getThreadCount() {
   return detail::Executor::getDefaultExecutor()->getThreadCount();
 }
+
+std::vector<WorkerStats> getWorkerStats() {
+  return detail::Executor::getDefaultExecutor()->getWorkerStats();
+}
 #endif
 
-// Latch::sync() called by the dtor may cause one thread to block. If is a dead
-// lock if all threads in the default executor are blocked. To prevent the dead
-// lock, only allow the root TaskGroup to run tasks parallelly. In the scenario
-// of nested parallel_for_each(), only the outermost one runs parallelly.
+// Nested TaskGroups run in parallel too: a worker thread that waits for a
+// nested TaskGroup in sync() first runs the queued tasks of that group, so the
+// executor cannot run out of threads.
 TaskGroup::TaskGroup()
 #if LLVM_ENABLE_THREADS
-    : Parallel((parallel::strategy.ThreadsRequested != 1) &&
-               (threadIndex == UINT_MAX)) {}
+    : Parallel(parallel::strategy.ThreadsRequested != 1) {}
 #else
     : Parallel(false) {}
 #endif
 TaskGroup::~TaskGroup() {
   // We must ensure that all the workloads have finished before decrementing the
   // instances count.
+  sync();
+}
+
+void TaskGroup::sync() const {
+#if LLVM_ENABLE_THREADS
+  // Only tasks of this group are run here. Running unrelated tasks would nest
+  // them on this stack without bound, and could deadlock if they take a lock
+  // that the caller holds. Once none are queued, the remaining ones are
+  // running on other threads and it is safe to block.
+  if (Parallel && threadIndex != UINT_MAX) {
+    detail::Executor *Exec = detail::Executor::getDefaultExecutor();
+    while (!L.isDone() && Exec->runPendingTask(this))
+      ;
+  }
+#endif
   L.sync();
 }
 
@@ -195,10 +385,12 @@ void TaskGroup::spawn(std::function<void()> F) {
 #if LLVM_ENABLE_THREADS
   if (Parallel) {
     L.inc();
-    detail::Executor::getDefaultExecutor()->add([&, F = std::move(F)] {
-      F();
-      L.dec();
-    });
+    detail::Executor::getDefaultExecutor()->add(
+        [&, F = std::move(F)] {
+          F();
+          L.dec();
+        },
+        this);
     return;
   }
 #endif
@@ -73,7 +73,7 @@ using NameAndCountAndDurationType =
 struct llvm::TimeTraceProfilerEntry {
   const TimePointType Start;
   TimePointType End;
-  const std::string Name;
+  std::string Name;
   TimeTraceMetadata Metadata;
 
   const TimeTraceEventType EventType = TimeTraceEventType::CompleteEvent;
@@ -183,14 +183,6 @@ struct llvm::TimeTraceProfiler {
         });
     assert(Iter != Stack.end() && "Event not in the Stack");
 
-    // Only include sections longer or equal to TimeTraceGranularity msec.
-    if (duration_cast<microseconds>(Duration).count() >= TimeTraceGranularity) {
-      Entries.emplace_back(E);
-      for (auto &IE : Iter->get()->InstantEvents) {
-        Entries.emplace_back(IE);
-      }
-    }
-
     // Track total time taken by each "name", but only the topmost levels of
     // them; e.g. if there's a template instantiation that instantiates other
     // templates from within, we only want to add the topmost one. "topmost"
@@ -205,6 +197,15 @@ struct llvm::TimeTraceProfiler {
       CountAndTotal.second += Duration;
     };
 
+    // Only include sections longer or equal to TimeTraceGranularity msec. The
+    // entry is about to be popped, so move its strings rather than copy them.
+    if (duration_cast<microseconds>(Duration).count() >= TimeTraceGranularity) {
+      Entries.emplace_back(std::move(E));
+      for (auto &IE : Iter->get()->InstantEvents) {
+        Entries.emplace_back(std::move(IE));
+      }
+    }
+
     Stack.erase(Iter);
   }
 
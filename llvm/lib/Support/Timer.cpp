@@ -36,6 +36,14 @@
 #include <libproc.h>
 #endif
 
+#if defined(__linux__) && defined(HAVE_UNISTD_H) &&                          \
+    __has_include(<linux/perf_event.h>)
+#define LLVM_TIMER_HAVE_PERF_EVENT 1
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#endif
+
 using namespace llvm;
 
 //===----------------------------------------------------------------------===//
@@ -113,6 +121,42 @@ static inline size_t getMemUsage() {
   return sys::Process::GetMallocUsage();
 }
 
+#ifdef LLVM_TIMER_HAVE_PERF_EVENT
+namespace {
+/// A user-space instruction counter for the calling thread, opened on first
+/// use. If the kernel refuses (e.g. because of perf_event_paranoid), the
+/// counter stays closed and reads as zero, which hides the column.
+struct PerfInstructionCounter {
+  int FD = -1;
+
+  PerfInstructionCounter() {
+    perf_event_attr Attr;
+    std::memset(&Attr, 0, sizeof(Attr));
+    Attr.type = PERF_TYPE_HARDWARE;
+    Attr.size = sizeof(Attr);
+    Attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    Attr.exclude_kernel = 1;
+    Attr.exclude_hv = 1;
+    // Don't leak the descriptor into processes spawned by the compiler.
+    FD = static_cast<int>(syscall(SYS_perf_event_open, &Attr, /*pid=*/0,
+                                  /*cpu=*/-1, /*group_fd=*/-1,
+                                  PERF_FLAG_FD_CLOEXEC));
+  }
+  ~PerfInstructionCounter() {
+    if (FD >= 0)
+      close(FD);
+  }
+
+  uint64_t read() const {
+    uint64_t Count = 0;
+    if (FD < 0 || ::read(FD, &Count, sizeof(Count)) != sizeof(Count))
+      return 0;
+    return Count;
+  }
+};
+} // namespace
+#endif
+
 static uint64_t getCurInstructionsExecuted() {
 #if defined(HAVE_UNISTD_H) && defined(HAVE_PROC_PID_RUSAGE) &&                 \
     defined(RUSAGE_INFO_V4)
@@ -120,6 +164,11 @@ static uint64_t getCurInstructionsExecuted() {
   if (proc_pid_rusage(getpid(), RUSAGE_INFO_V4, (rusage_info_t *)&ru) == 0) {
     return ru.ri_instructions;
   }
+#elif defined(LLVM_TIMER_HAVE_PERF_EVENT)
+  // Unlike the Darwin counter above, this one counts the calling thread only,
+  // which matches how timers are started and stopped.
+  static thread_local PerfInstructionCounter Counter;
+  return Counter.read();
 #endif
   return 0;
 }
@@ -1746,12 +1746,22 @@ public:
       }
     } else { // Advance to the next component
       auto *DE = dyn_cast<RedirectingFileSystem::DirectoryEntry>(ParentEntry);
-      for (std::unique_ptr<RedirectingFileSystem::Entry> &Content :
-           llvm::make_range(DE->contents_begin(), DE->contents_end())) {
-        auto *DirContent =
-            dyn_cast<RedirectingFileSystem::DirectoryEntry>(Content.get());
-        if (DirContent && Name == Content->getName())
-          return DirContent;
+      if (std::optional<ArrayRef<unsigned>> Candidates =
+              DE->findContents(Name)) {
+        for (unsigned I : *Candidates) {
+          auto *DirContent = dyn_cast<RedirectingFileSystem::DirectoryEntry>(
+              DE->getContent(I));
+          if (DirContent && Name == DirContent->getName())
+            return DirContent;
+        }
+      } else {
+        for (std::unique_ptr<RedirectingFileSystem::Entry> &Content :
+             llvm::make_range(DE->contents_begin(), DE->contents_end())) {
+          auto *DirContent =
+              dyn_cast<RedirectingFileSystem::DirectoryEntry>(Content.get());
+          if (DirContent && Name == Content->getName())
+            return DirContent;
+        }
       }
     }
 
@@ -2362,19 +2372,57 @@ RedirectingFileSystem::lookupPathImpl(
     return LookupResult(From, Start, End);
 
   auto *DE = cast<RedirectingFileSystem::DirectoryEntry>(From);
+  auto LookupIn = [&](RedirectingFileSystem::Entry *DirEntry) {
+    Entries.push_back(From);
+    ErrorOr<RedirectingFileSystem::LookupResult> Result =
+        lookupPathImpl(Start, End, DirEntry, Entries);
+    if (!Result && Result.getError() == llvm::errc::no_such_file_or_directory)
+      Entries.pop_back();
+    return Result;
+  };
+  if (std::optional<ArrayRef<unsigned>> Candidates =
+          DE->findContents(*Start)) {
+    for (unsigned I : *Candidates) {
+      ErrorOr<RedirectingFileSystem::LookupResult> Result =
+          LookupIn(DE->getContent(I));
+      if (Result || Result.getError() != llvm::errc::no_such_file_or_directory)
+        return Result;
+    }
+    return make_error_code(llvm::errc::no_such_file_or_directory);
+  }
   for (const std::unique_ptr<RedirectingFileSystem::Entry> &DirEntry :
        llvm::make_range(DE->contents_begin(), DE->contents_end())) {
-    Entries.push_back(From);
     ErrorOr<RedirectingFileSystem::LookupResult> Result =
-        lookupPathImpl(Start, End, DirEntry.get(), Entries);
+        LookupIn(DirEntry.get());
     if (Result || Result.getError() != llvm::errc::no_such_file_or_directory)
       return Result;
-    Entries.pop_back();
   }
 
   return make_error_code(llvm::errc::no_such_file_or_directory);
 }
 
+void RedirectingFileSystem::DirectoryEntry::indexContent(unsigned I) {
+  if (HasEmptyNamedContent)
+    return;
+  StringRef Name = Contents[I]->getName();
+  if (Name.empty()) {
+    HasEmptyNamedContent = true;
+    ContentsByName.clear();
+    return;
+  }
+  ContentsByName[Name.lower()].push_back(I);
+}
+
+std::optional<ArrayRef<unsigned>>
+RedirectingFileSystem::DirectoryEntry::findContents(StringRef Name) const {
+  if (Contents.size() < IndexThreshold || HasEmptyNamedContent)
+    return std::nullopt;
+  auto It = ContentsByName.find(Name.lower());
+  if (It == ContentsByName.end())
+    return ArrayRef<unsigned>();
+  return ArrayRef<unsigned>(It->second);
+}
+
 static Status getRedirectedFileStatus(const Twine &OriginalPath,
                                       bool UseExternalNames,
                                       Status ExternalStatus) {
@@ -113,6 +113,9 @@ STATISTIC(NumUniqueRetVal, "Number of unique return value optimizations");
 STATISTIC(NumVirtConstProp1Bit,
           "Number of 1 bit virtual constant propagations");
 STATISTIC(NumVirtConstProp, "Number of virtual constant propagations");
+STATISTIC(NumVirtCallSlots, "Number of virtual call slots considered");
+STATISTIC(NumDevirtCallSlots,
+          "Number of virtual call slots with all call sites devirtualized");
 
 static cl::opt<PassSummaryAction> ClSummaryAction(
     "wholeprogramdevirt-summary-action",
@@ -543,6 +546,16 @@ struct VTableSlotInfo {
 
   void addCallSite(Value *VTable, CallBase &CB, unsigned *NumUnsafeUses);
 
+  /// Whether every call site in this slot, including those with constant
+  /// arguments, has been devirtualized.
+  bool allCallSitesDevirted() const {
+    return CSInfo.AllCallSitesDevirted &&
+           all_of(make_second_range(ConstCSInfo),
+                  [](const CallSiteInfo &CSI) {
+                    return CSI.AllCallSitesDevirted;
+                  });
+  }
+
 private:
   CallSiteInfo &findCallSiteInfo(CallBase &CB);
 };
@@ -1439,15 +1452,7 @@ void DevirtModule::tryICallBranchFunnel(
   if (TargetsForSlot.size() > ClThreshold)
     return;
 
-  bool HasNonDevirt = !SlotInfo.CSInfo.AllCallSitesDevirted;
-  if (!HasNonDevirt)
-    for (auto &P : SlotInfo.ConstCSInfo)
-      if (!P.second.AllCallSitesDevirted) {
-        HasNonDevirt = true;
-        break;
-      }
-
-  if (!HasNonDevirt)
+  if (SlotInfo.allCallSitesDevirted())
     return;
 
   // If any GV is AvailableExternally, not to generate branch.funnel.
@@ -2432,6 +2437,7 @@ bool DevirtModule::run() {
   // For each (type, offset) pair:
   bool DidVirtualConstProp = false;
   std::map<std::string, GlobalValue *> DevirtTargets;
+  NumVirtCallSlots += CallSlots.size();
   for (auto &S : CallSlots) {
     // Search each of the members of the type identifier for the virtual
     // function implementation at offset S.first.ByteOffset, and add to
@@ -2466,6 +2472,9 @@ bool DevirtModule::run() {
         for (const auto &T : TargetsForSlot)
           if (T.WasDevirt)
             DevirtTargets[std::string(T.Fn->getName())] = T.Fn;
+
+      if (S.second.allCallSitesDevirted())
+        ++NumDevirtCallSlots;
     }
 
     // CFI-specific: if we are exporting and any llvm.type.checked.load
@@ -2581,6 +2590,7 @@ void DevirtIndex::run() {
   }
 
   std::set<ValueInfo> DevirtTargets;
+  NumVirtCallSlots += CallSlots.size();
   // For each (type, offset) pair:
   for (auto &S : CallSlots) {
     // Search each of the members of the type identifier for the virtual
@@ -2600,6 +2610,7 @@ void DevirtIndex::run() {
       if (!trySingleImplDevirt(TargetsForSlot, S.first, S.second, Res,
                                DevirtTargets))
         continue;
+      ++NumDevirtCallSlots;
     }
   }
 
@@ -3036,8 +3036,11 @@ bool AddressSanitizer::instrumentFunction(Function &F,
   markEscapedLocalAllocas(F);
 
   // We want to instrument every address only once per basic block (unless there
-  // are calls between uses).
+  // are calls between uses). A block with a single predecessor also inherits
+  // the addresses checked at the end of that predecessor, since those checks
+  // dominate it and no call can intervene.
   SmallPtrSet<Value *, 16> TempsToInstrument;
+  DenseMap<const BasicBlock *, SmallPtrSet<Value *, 16>> TempsAtBlockExit;
   SmallVector<InterestingMemoryOperand, 16> OperandsToInstrument;
   SmallVector<MemIntrinsic *, 16> IntrinToInstrument;
   SmallVector<Instruction *, 8> NoReturnCalls;
@@ -3048,7 +3051,14 @@ bool AddressSanitizer::instrumentFunction(Function &F,
   for (auto &BB : F) {
     AllBlocks.push_back(&BB);
     TempsToInstrument.clear();
+    if (ClOpt && ClOptSameTemp)
+      if (const BasicBlock *Pred = BB.getSinglePredecessor()) {
+        auto It = TempsAtBlockExit.find(Pred);
+        if (It != TempsAtBlockExit.end())
+          TempsToInstrument = It->second;
+      }
     int NumInsnsPerBB = 0;
+    bool ScannedWholeBB = true;
     for (auto &Inst : BB) {
       if (LooksLikeCodeInBug11395(&Inst)) return false;
       // Skip instructions inserted by another instrumentation.
@@ -3094,8 +3104,13 @@ bool AddressSanitizer::instrumentFunction(Function &F,
         if (CallInst *CI = dyn_cast<CallInst>(&Inst))
           maybeMarkSanitizerLibraryCallNoBuiltin(CI, TLI);
       }
-      if (NumInsnsPerBB >= ClMaxInsnsToInstrumentPerBB) break;
+      if (NumInsnsPerBB >= ClMaxInsnsToInstrumentPerBB) {
+        ScannedWholeBB = false;
+        break;
+      }
     }
+    if (ClOpt && ClOptSameTemp && ScannedWholeBB && !TempsToInstrument.empty())
+      TempsAtBlockExit[&BB] = TempsToInstrument;
   }
 
   bool UseCalls = (InstrumentationWithCallsThreshold >= 0 &&
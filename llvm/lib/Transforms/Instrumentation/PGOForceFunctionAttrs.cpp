@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Transforms/Instrumentation/PGOForceFunctionAttrs.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Analysis/BlockFrequencyInfo.h"
 #include "llvm/Analysis/ProfileSummaryInfo.h"
 #include "llvm/IR/Module.h"
@@ -15,6 +16,11 @@
 
 using namespace llvm;
 
+#define DEBUG_TYPE "pgo-force-function-attrs"
+
+STATISTIC(NumColdFunctionsMarked,
+          "Number of cold functions given a reduced optimization attribute");
+
 static bool shouldRunOnFunction(Function &F, ProfileSummaryInfo &PSI,
                                 FunctionAnalysisManager &FAM) {
   if (F.isDeclaration())
@@ -59,6 +65,7 @@ PreservedAnalyses PGOForceFunctionAttrsPass::run(Module &M,
       F.addFnAttr(Attribute::NoInline);
       break;
     }
+    ++NumColdFunctionsMarked;
     MadeChange = true;
   }
   return MadeChange ? PreservedAnalyses::none() : PreservedAnalyses::all();
@@ -138,6 +138,7 @@ private:
                                       SmallVectorImpl<InstructionInfo> &All,
                                       const DataLayout &DL);
   bool addrPointsToConstantData(Value *Addr);
+  bool allocaMayBeCaptured(const AllocaInst *AI);
   int getMemoryAccessFuncIndex(Type *OrigTy, Value *Addr, const DataLayout &DL);
   void InsertRuntimeIgnores(Function &F);
 
@@ -168,6 +169,11 @@ private:
   FunctionCallee TsanVptrUpdate;
   FunctionCallee TsanVptrLoad;
   FunctionCallee MemmoveFn, MemcpyFn, MemsetFn;
+
+  // Whether each alloca accessed in the function may be captured. Capture
+  // tracking walks all uses of the alloca, so compute it once per alloca
+  // rather than once per access.
+  DenseMap<const AllocaInst *, bool> AllocaCaptured;
 };
 
 void insertModuleCtor(Module &M) {
@@ -450,7 +456,7 @@ void ThreadSanitizer::chooseInstructionsToInstrument(
 
     const AllocaInst *AI = findAllocaForValue(Addr);
     // Instead of Addr, we should check whether its base pointer is captured.
-    if (AI && !PointerMayBeCaptured(AI, /*ReturnCaptures=*/true)) {
+    if (AI && !allocaMayBeCaptured(AI)) {
       // The variable is addressable but not captured, so it cannot be
       // referenced from a different thread and participate in a data race
       // (see llvm/Analysis/CaptureTracking.h for details).
@@ -469,6 +475,13 @@ void ThreadSanitizer::chooseInstructionsToInstrument(
   Local.clear();
 }
 
+bool ThreadSanitizer::allocaMayBeCaptured(const AllocaInst *AI) {
+  auto [It, Inserted] = AllocaCaptured.try_emplace(AI);
+  if (Inserted)
+    It->second = PointerMayBeCaptured(AI, /*ReturnCaptures=*/true);
+  return It->second;
+}
+
 static bool isTsanAtomic(const Instruction *I) {
   // TODO: Ask TTI whether synchronization scope is between threads.
   auto SSID = getAtomicSyncScopeID(I);
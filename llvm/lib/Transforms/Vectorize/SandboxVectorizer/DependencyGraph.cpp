@@ -10,9 +10,19 @@
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/SandboxIR/Instruction.h"
 #include "llvm/SandboxIR/Utils.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Transforms/Vectorize/SandboxVectorizer/Scheduler.h"
 
-namespace llvm::sandboxir {
+namespace llvm {
+
+static cl::opt<unsigned>
+    AABudget("sbvec-dag-aa-budget", cl::init(256), cl::Hidden,
+             cl::desc("Maximum number of alias queries per memory "
+                      "instruction when building the dependency graph. Once "
+                      "exceeded, dependencies are conservatively assumed. 0 "
+                      "means unlimited."));
+
+namespace sandboxir {
 
 User::op_iterator PredIterator::skipBadIt(User::op_iterator OpIt,
                                           User::op_iterator OpItE,
@@ -179,7 +189,7 @@ static bool isOrdered(Instruction *I) {
 }
 
 bool DependencyGraph::alias(Instruction *SrcI, Instruction *DstI,
-                            DependencyType DepType) {
+                            DependencyType DepType, unsigned &BudgetLeft) {
   std::optional<MemoryLocation> DstLocOpt =
       Utils::memoryLocationGetOrNone(DstI);
   if (!DstLocOpt)
@@ -187,7 +197,13 @@ bool DependencyGraph::alias(Instruction *SrcI, Instruction *DstI,
   // Check aliasing.
   assert((SrcI->mayReadFromMemory() || SrcI->mayWriteToMemory()) &&
          "Expected a mem instr");
-  // TODO: Check AABudget
+  // Once the budget is used up we stop querying AA and assume the worst, so
+  // that the cost of building the DAG stays linear in the size of the region.
+  if (AABudget != 0) {
+    if (BudgetLeft == 0)
+      return true;
+    --BudgetLeft;
+  }
   ModRefInfo SrcModRef =
       isOrdered(SrcI)
           ? ModRefInfo::ModRef
@@ -203,13 +219,14 @@ bool DependencyGraph::alias(Instruction *SrcI, Instruction *DstI,
   }
 }
 
-bool DependencyGraph::hasDep(Instruction *SrcI, Instruction *DstI) {
+bool DependencyGraph::hasDep(Instruction *SrcI, Instruction *DstI,
+                             unsigned &BudgetLeft) {
   DependencyType RoughDepType = getRoughDepType(SrcI, DstI);
   switch (RoughDepType) {
   case DependencyType::ReadAfterWrite:
   case DependencyType::WriteAfterWrite:
   case DependencyType::WriteAfterRead:
-    return alias(SrcI, DstI, RoughDepType);
+    return alias(SrcI, DstI, RoughDepType, BudgetLeft);
   case DependencyType::Control:
     // Adding actual dep edges from PHIs/to terminator would just create too
     // many edges, which would be bad for compile-time.
@@ -231,9 +248,10 @@ void DependencyGraph::scanAndAddDeps(MemDGNode &DstN,
   Instruction *DstI = DstN.getInstruction();
   // Walk up the instruction chain from ScanRange bottom to top, looking for
   // memory instrs that may alias.
+  unsigned BudgetLeft = AABudget;
   for (MemDGNode &SrcN : reverse(SrcScanRange)) {
     Instruction *SrcI = SrcN.getInstruction();
-    if (hasDep(SrcI, DstI))
+    if (hasDep(SrcI, DstI, BudgetLeft))
       DstN.addMemPred(&SrcN);
   }
 }
@@ -662,4 +680,5 @@ void DependencyGraph::dump() const {
 }
 #endif // NDEBUG
 
-} // namespace llvm::sandboxir
+} // namespace sandboxir
+} // namespace llvm
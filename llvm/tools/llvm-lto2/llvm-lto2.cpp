@@ -56,6 +56,12 @@ static cl::opt<std::string> OutputFilename("o", cl::Required,
 static cl::opt<std::string> CacheDir("cache-dir", cl::desc("Cache Directory"),
                                      cl::value_desc("directory"));
 
+static cl::opt<std::string> SharedCacheDir(
+    "shared-cache-dir",
+    cl::desc("Directory of a cache shared between machines that is used as a "
+             "second level below --cache-dir"),
+    cl::value_desc("directory"));
+
 static cl::opt<std::string> OptPipeline("opt-pipeline",
                                         cl::desc("Optimizer Pipeline"),
                                         cl::value_desc("pipeline"));
@@ -483,9 +489,13 @@ static int run(int argc, char **argv) {
   };
 
   FileCache Cache;
-  if (!CacheDir.empty())
+  if (!CacheDir.empty()) {
     Cache = check(localCache("ThinLTO", "Thin", CacheDir, AddBuffer),
                   "failed to create cache");
+    if (!SharedCacheDir.empty())
+      Cache = tieredCache(std::move(Cache),
+                          createDirectoryCacheStore(SharedCacheDir));
+  }
 
   check(Lto.run(AddStream, Cache), "LTO::run failed");
   return static_cast<int>(HasErrors);
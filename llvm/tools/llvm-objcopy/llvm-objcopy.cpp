@@ -7,6 +7,8 @@
 //===----------------------------------------------------------------------===//
 
 #include "ObjcopyOptions.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/Twine.h"
@@ -30,9 +32,11 @@
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/ErrorOr.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/FileUtilities.h"
 #include "llvm/Support/LLVMDriver.h"
 #include "llvm/Support/Memory.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Process.h"
 #include "llvm/Support/StringSaver.h"
@@ -235,7 +239,49 @@ int llvm_objcopy_main(int argc, char **argv, const llvm::ToolContext &) {
   }
 
   int ret = 0;
-  for (ConfigManager &ConfigMgr : DriverConfig->CopyConfigs) {
+  MutableArrayRef<ConfigManager> Configs = DriverConfig->CopyConfigs;
+
+  // With several inputs (e.g. llvm-strip a.so b.so ...), each one is an
+  // independent copy, so process them concurrently as long as they write
+  // distinct files. Outputs are compared by file identity rather than by name,
+  // so that e.g. "a.o", "./a.o" and hard links to it are recognized as the
+  // same file; if that cannot be determined, the inputs are processed in
+  // order. Diagnostics are buffered per input and printed in input order, so
+  // the output doesn't depend on scheduling.
+  DenseSet<sys::fs::UniqueID> OutputFiles;
+  bool DistinctOutputs = llvm::all_of(Configs, [&](const ConfigManager &C) {
+    sys::fs::UniqueID ID;
+    return C.Common.OutputFilename != "-" &&
+           !sys::fs::getUniqueID(C.Common.OutputFilename, ID) &&
+           OutputFiles.insert(ID).second;
+  });
+  if (Configs.size() > 1 && DistinctOutputs) {
+    std::vector<std::string> Diagnostics(Configs.size());
+    std::vector<char> Failed(Configs.size(), false);
+    parallelFor(0, Configs.size(), [&](size_t I) {
+      raw_string_ostream OS(Diagnostics[I]);
+      OS.enable_colors(errs().has_colors());
+      ConfigManager &ConfigMgr = Configs[I];
+      assert(!ConfigMgr.Common.ErrorCallback);
+      ConfigMgr.Common.ErrorCallback = [&OS](Error E) -> Error {
+        WithColor::warning(OS, ToolName) << toString(std::move(E)) << '\n';
+        return Error::success();
+      };
+      if (Error E = executeObjcopy(ConfigMgr)) {
+        logAllUnhandledErrors(std::move(E), WithColor::error(OS, ToolName));
+        Failed[I] = true;
+      }
+      ConfigMgr.Common.ErrorCallback = nullptr;
+    });
+    for (size_t I = 0, E = Configs.size(); I != E; ++I) {
+      errs() << Diagnostics[I];
+      if (Failed[I])
+        ret = 1;
+    }
+    return ret;
+  }
+
+  for (ConfigManager &ConfigMgr : Configs) {
     assert(!ConfigMgr.Common.ErrorCallback);
     ConfigMgr.Common.ErrorCallback = reportWarning;
     if (Error E = executeObjcopy(ConfigMgr)) {
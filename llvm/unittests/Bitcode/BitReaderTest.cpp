@@ -13,6 +13,7 @@
 #include "llvm/Bitcode/BitcodeReader.h"
 #include "llvm/Bitcode/BitcodeWriter.h"
 #include "llvm/IR/Constants.h"
+#include "llvm/IR/DebugInfoMetadata.h"
 #include "llvm/IR/InstrTypes.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
@@ -257,6 +258,73 @@ TEST(BitReaderTest, MaterializeFunctionsForBlockAddrInFunctionAfter) {
   EXPECT_FALSE(verifyModule(*M, &dbgs()));
 }
 
+static const char *CompileUnitListsAssembly =
+    "define void @f() !dbg !6 {\n"
+    "  ret void, !dbg !9\n"
+    "}\n"
+    "!llvm.dbg.cu = !{!0}\n"
+    "!llvm.module.flags = !{!10}\n"
+    "!0 = distinct !DICompileUnit(language: DW_LANG_C99, file: !1, "
+    "producer: \"clang\", isOptimized: true, runtimeVersion: 0, "
+    "emissionKind: FullDebug, enums: !2, retainedTypes: !5)\n"
+    "!1 = !DIFile(filename: \"a.c\", directory: \"/\")\n"
+    "!2 = !{!3}\n"
+    "!3 = !DICompositeType(tag: DW_TAG_enumeration_type, name: \"E\", "
+    "file: !1, line: 1, size: 32, elements: !4)\n"
+    "!4 = !{}\n"
+    "!5 = !{!11}\n"
+    "!6 = distinct !DISubprogram(name: \"f\", scope: !1, file: !1, line: 2, "
+    "type: !7, spFlags: DISPFlagDefinition, unit: !0)\n"
+    "!7 = !DISubroutineType(types: !8)\n"
+    "!8 = !{null}\n"
+    "!9 = !DILocation(line: 2, scope: !6)\n"
+    "!10 = !{i32 2, !\"Debug Info Version\", i32 3}\n"
+    "!11 = !DIBasicType(name: \"int\", size: 32, encoding: DW_ATE_signed)\n";
+
+static DICompileUnit *getOnlyCompileUnit(Module &M) {
+  NamedMDNode *CUs = M.getNamedMetadata("llvm.dbg.cu");
+  if (!CUs || CUs->getNumOperands() != 1)
+    return nullptr;
+  return dyn_cast<DICompileUnit>(CUs->getOperand(0));
+}
+
+// Tests that the compile unit lists that the IRMover drops when importing are
+// not loaded when reading a module for ThinLTO importing.
+TEST(BitReaderTest, ImportingSkipsCompileUnitLists) {
+  SmallString<1024> Mem;
+  LLVMContext Context;
+  LLVMContext OtherContext;
+  writeModuleToBuffer(parseAssembly(Context, CompileUnitListsAssembly), Mem);
+
+  Expected<std::unique_ptr<Module>> ModuleOrErr =
+      getLazyBitcodeModule(MemoryBufferRef(Mem.str(), "test"), Context,
+                           /*ShouldLazyLoadMetadata=*/true,
+                           /*IsImporting=*/true);
+  if (!ModuleOrErr)
+    report_fatal_error("Could not parse bitcode module");
+  std::unique_ptr<Module> M = std::move(*ModuleOrErr);
+  EXPECT_FALSE(M->materializeMetadata());
+  EXPECT_FALSE(M->getFunction("f")->materialize());
+
+  DICompileUnit *CU = getOnlyCompileUnit(*M);
+  ASSERT_TRUE(CU);
+  EXPECT_TRUE(CU->getEnumTypes().empty());
+  EXPECT_TRUE(CU->getRetainedTypes().empty());
+  EXPECT_EQ(M->getFunction("f")->getSubprogram()->getUnit(), CU);
+
+  // Without importing, the lists are loaded as usual.
+  ModuleOrErr = getLazyBitcodeModule(MemoryBufferRef(Mem.str(), "test"),
+                                     OtherContext);
+  if (!ModuleOrErr)
+    report_fatal_error("Could not parse bitcode module");
+  M = std::move(*ModuleOrErr);
+  EXPECT_FALSE(M->materializeMetadata());
+  CU = getOnlyCompileUnit(*M);
+  ASSERT_TRUE(CU);
+  EXPECT_EQ(CU->getEnumTypes().size(), 1u);
+  EXPECT_EQ(CU->getRetainedTypes().size(), 1u);
+}
+
 // Helper function to convert type metadata to a string for testing
 static std::string mdToString(Metadata *MD) {
   std::string S;
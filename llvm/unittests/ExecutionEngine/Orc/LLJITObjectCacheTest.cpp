@@ -0,0 +1,103 @@
+//===- LLJITObjectCacheTest.cpp - Unit tests for LLJIT's ObjectCache hook -===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "OrcTestCommon.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
+#include "llvm/ExecutionEngine/Orc/LLJIT.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Testing/Support/Error.h"
+#include "gtest/gtest.h"
+
+#include <mutex>
+
+using namespace llvm;
+using namespace llvm::orc;
+
+namespace {
+
+/// An in-memory ObjectCache keyed by module identifier that counts how often
+/// it is written to and how often it provides an object.
+class CountingObjectCache : public ObjectCache {
+public:
+  void notifyObjectCompiled(const Module *M, MemoryBufferRef Obj) override {
+    std::lock_guard<std::mutex> Lock(CacheMutex);
+    ++NumCompiled;
+    Objects[M->getModuleIdentifier()] = MemoryBuffer::getMemBufferCopy(
+        Obj.getBuffer(), Obj.getBufferIdentifier());
+  }
+
+  std::unique_ptr<MemoryBuffer> getObject(const Module *M) override {
+    std::lock_guard<std::mutex> Lock(CacheMutex);
+    auto I = Objects.find(M->getModuleIdentifier());
+    if (I == Objects.end())
+      return nullptr;
+    ++NumHits;
+    return MemoryBuffer::getMemBufferCopy(I->second->getBuffer(),
+                                          I->second->getBufferIdentifier());
+  }
+
+  unsigned NumCompiled = 0;
+  unsigned NumHits = 0;
+
+private:
+  std::mutex CacheMutex;
+  StringMap<std::unique_ptr<MemoryBuffer>> Objects;
+};
+
+/// Build a module defining `int answer() { return 42; }`.
+ThreadSafeModule createAnswerModule() {
+  auto Ctx = std::make_unique<LLVMContext>();
+  auto M = std::make_unique<Module>("answer", *Ctx);
+  Function *F = Function::Create(
+      FunctionType::get(Type::getInt32Ty(*Ctx), /*isVarArg=*/false),
+      GlobalValue::ExternalLinkage, "answer", *M);
+  IRBuilder<> B(BasicBlock::Create(*Ctx, "entry", F));
+  B.CreateRet(B.getInt32(42));
+  return ThreadSafeModule(std::move(M), std::move(Ctx));
+}
+
+/// Create an LLJIT using \p Cache, add the answer module to it, and check
+/// that calling `answer` returns 42.
+void runAnswer(CountingObjectCache &Cache) {
+  auto J = LLJITBuilder().setObjectCache(&Cache).create();
+  ASSERT_THAT_EXPECTED(J, Succeeded());
+  ASSERT_THAT_ERROR((*J)->addIRModule(createAnswerModule()), Succeeded());
+  auto Answer = (*J)->lookup("answer");
+  ASSERT_THAT_EXPECTED(Answer, Succeeded());
+  EXPECT_EQ(Answer->toPtr<int (*)()>()(), 42);
+}
+
+TEST(LLJITObjectCacheTest, CompiledObjectIsReused) {
+  OrcNativeTarget::initialize();
+
+  // Bail out if this host cannot run LLJIT at all.
+  auto J = LLJITBuilder().create();
+  if (!J) {
+    consumeError(J.takeError());
+    GTEST_SKIP();
+  }
+  J->reset();
+
+  CountingObjectCache Cache;
+
+  // The first session compiles the module and hands the object to the cache.
+  runAnswer(Cache);
+  EXPECT_EQ(Cache.NumCompiled, 1U);
+  EXPECT_EQ(Cache.NumHits, 0U);
+
+  // The second session loads the cached object instead of compiling.
+  runAnswer(Cache);
+  EXPECT_EQ(Cache.NumCompiled, 1U);
+  EXPECT_EQ(Cache.NumHits, 1U);
+}
+
+} // namespace
@@ -88,6 +88,7 @@ protected:
         *ES, std::make_unique<InProcessMemoryManager>(*PageSize));
     DL = std::make_unique<DataLayout>(std::move(*DLOrErr));
 
+    HostJTMB.emplace(*JTMB);
     auto TM = JTMB->createTargetMachine();
     if (!TM) {
       consumeError(TM.takeError());
@@ -107,7 +108,10 @@ protected:
     return ROLayer->add(std::move(RT), std::move(TSM));
   }
 
+  void testDefaultPipeline(OptimizationLevel Level);
+
   JITDylib *JD{nullptr};
+  std::optional<JITTargetMachineBuilder> HostJTMB;
   std::unique_ptr<ExecutionSession> ES;
   std::unique_ptr<ObjectLinkingLayer> ObjLinkingLayer;
   std::unique_ptr<IRCompileLayer> CompileLayer;
@@ -188,3 +192,63 @@ TEST_F(ReOptimizeLayerTest, BasicReOptimization) {
     EXPECT_EQ(FuncPtr(), 42);
   EXPECT_EQ(FuncPtr(), 53);
 }
+
+void ReOptimizeLayerTest::testDefaultPipeline(OptimizationLevel Level) {
+  MangleAndInterner Mangle(*ES, *DL);
+
+  auto &EPC = ES->getExecutorProcessControl();
+  EXPECT_THAT_ERROR(JD->define(absoluteSymbols(
+                        {{Mangle("__orc_rt_jit_dispatch"),
+                          {EPC.getJITDispatchInfo().JITDispatchFunction,
+                           JITSymbolFlags::Exported}},
+                         {Mangle("__orc_rt_jit_dispatch_ctx"),
+                          {EPC.getJITDispatchInfo().JITDispatchContext,
+                           JITSymbolFlags::Exported}},
+                         {Mangle("__orc_rt_reoptimize_tag"),
+                          {ExecutorAddr(), JITSymbolFlags::Exported}}})),
+                    Succeeded());
+
+  auto RM = JITLinkRedirectableSymbolManager::Create(*ObjLinkingLayer);
+  EXPECT_THAT_ERROR(RM.takeError(), Succeeded());
+
+  ROLayer = std::make_unique<ReOptimizeLayer>(*ES, *DL, *CompileLayer, **RM);
+  unsigned ReOptimizations = 0;
+  auto DefaultPipeline = ReOptimizeLayer::runDefaultPipeline(*HostJTMB, Level);
+  ROLayer->setReoptimizeFunc(
+      [&](ReOptimizeLayer &Parent,
+          ReOptimizeLayer::ReOptMaterializationUnitID MUID, unsigned CurVersion,
+          ResourceTrackerSP OldRT, ThreadSafeModule &TSM) {
+        ++ReOptimizations;
+        return DefaultPipeline(Parent, MUID, CurVersion, std::move(OldRT),
+                               TSM);
+      });
+  EXPECT_THAT_ERROR(ROLayer->reigsterRuntimeFunctions(*JD), Succeeded());
+
+  auto Ctx = std::make_unique<LLVMContext>();
+  auto M = std::make_unique<Module>("<main>", *Ctx);
+  M->setTargetTriple(Triple(sys::getProcessTriple()));
+
+  (void)createRetFunction(M.get(), "main", 42);
+
+  EXPECT_THAT_ERROR(addIRModule(JD->getDefaultResourceTracker(),
+                                ThreadSafeModule(std::move(M), std::move(Ctx))),
+                    Succeeded());
+
+  // The optimized version must behave like the original one.
+  auto Result = cantFail(ES->lookup({JD}, Mangle("main")));
+  auto FuncPtr = Result.getAddress().toPtr<int (*)()>();
+  for (size_t I = 0; I <= ReOptimizeLayer::CallCountThreshold; I++)
+    EXPECT_EQ(FuncPtr(), 42);
+  EXPECT_EQ(FuncPtr(), 42);
+  EXPECT_EQ(ReOptimizations, 1u);
+}
+
+TEST_F(ReOptimizeLayerTest, DefaultPipelineO2) {
+  testDefaultPipeline(OptimizationLevel::O2);
+}
+
+TEST_F(ReOptimizeLayerTest, DefaultPipelineO0) {
+  // buildPerModuleDefaultPipeline asserts at O0, so this must use the O0
+  // pipeline.
+  testDefaultPipeline(OptimizationLevel::O0);
+}
@@ -0,0 +1,84 @@
+//===- LTOCacheKeyTest.cpp - Unit tests for computeLTOCacheKey ------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/IR/ModuleSummaryIndex.h"
+#include "llvm/LTO/Config.h"
+#include "llvm/LTO/LTO.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/SHA1.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Testing/Support/SupportHelpers.h"
+#include "llvm/Transforms/IPO/FunctionImport.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+class LTOCacheKeyTest : public testing::Test {
+protected:
+  LTOCacheKeyTest() : Index(/*HaveGVs=*/false), ImportList(ImportIDs) {
+    Index.addModule("m");
+  }
+
+  std::string computeKey(const lto::Config &Conf) {
+    return computeLTOCacheKey(Conf, Index, "m", ImportList, ExportList,
+                              ResolvedODR, DefinedGlobals);
+  }
+
+  ModuleSummaryIndex Index;
+  FunctionImporter::ImportIDTable ImportIDs;
+  FunctionImporter::ImportMapTy ImportList;
+  FunctionImporter::ExportSetTy ExportList;
+  std::map<GlobalValue::GUID, GlobalValue::LinkageTypes> ResolvedODR;
+  GVSummaryMapTy DefinedGlobals;
+};
+
+static void writeFile(StringRef Path, StringRef Contents) {
+  std::error_code EC;
+  raw_fd_ostream OS(Path, EC);
+  ASSERT_FALSE(EC);
+  OS << Contents;
+}
+
+TEST_F(LTOCacheKeyTest, SampleProfileContents) {
+  unittest::TempFile Profile("lto-cache-key", "prof", "foo:100:10\n",
+                             /*Unique=*/true);
+  lto::Config Conf;
+  std::string NoProfileKey = computeKey(Conf);
+
+  Conf.SampleProfile = Profile.path().str();
+  std::string Key1 = computeKey(Conf);
+  EXPECT_NE(NoProfileKey, Key1);
+
+  // Same size, different contents.
+  writeFile(Profile.path(), "bar:100:10\n");
+  std::string Key2 = computeKey(Conf);
+  EXPECT_NE(Key1, Key2);
+
+  // A digest computed up front, as LTO::runThinLTO does, gives the same key
+  // as reading the file.
+  Conf.SampleProfileHash = SHA1::hash(arrayRefFromStringRef("bar:100:10\n"));
+  EXPECT_EQ(Key2, computeKey(Conf));
+}
+
+TEST_F(LTOCacheKeyTest, ProfileRemappingContents) {
+  unittest::TempFile Profile("lto-cache-key", "prof", "foo:100:10\n",
+                             /*Unique=*/true);
+  unittest::TempFile Remapping("lto-cache-key", "map", "name _Z1f _Z1g\n",
+                               /*Unique=*/true);
+  lto::Config Conf;
+  Conf.SampleProfile = Profile.path().str();
+  Conf.ProfileRemapping = Remapping.path().str();
+  std::string Key1 = computeKey(Conf);
+
+  writeFile(Remapping.path(), "name _Z1g _Z1f\n");
+  EXPECT_NE(Key1, computeKey(Conf));
+}
+
+} // namespace
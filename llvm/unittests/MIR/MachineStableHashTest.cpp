@@ -211,3 +211,99 @@ body:             |
   EXPECT_NE(stableHashValue(*MF2), stableHashValue(*MF4));
   EXPECT_NE(stableHashValue(*MF3), stableHashValue(*MF4));
 }
+
+TEST_F(MachineStableHashTest, MultipleBlocks) {
+  auto TM = createTargetMachine(("aarch64--"), "", "");
+  if (!TM)
+    GTEST_SKIP();
+  StringRef MIRString = R"MIR(
+--- |
+  define void @f1() { ret void }
+  define void @f2() { ret void }
+  define void @f3() { ret void }
+  define void @f4() { ret void }
+...
+---
+name:            f1
+tracksRegLiveness: true
+body:             |
+  bb.0:
+    successors: %bb.1, %bb.2
+    liveins: $x0, $lr
+    CBZX $x0, %bb.2
+    B %bb.1
+  bb.1:
+    liveins: $lr
+    RET undef $lr
+  bb.2:
+    liveins: $lr
+    RET undef $lr
+...
+---
+name:            f2
+tracksRegLiveness: true
+body:             |
+  bb.0:
+    successors: %bb.1, %bb.2
+    liveins: $x0, $lr
+    CBZX $x0, %bb.2
+    B %bb.1
+  bb.1:
+    liveins: $lr
+    RET undef $lr
+  bb.2:
+    liveins: $lr
+    RET undef $lr
+...
+---
+name:            f3
+tracksRegLiveness: true
+body:             |
+  bb.0:
+    successors: %bb.1, %bb.2
+    liveins: $x0, $lr
+    CBZX $x0, %bb.1
+    B %bb.2
+  bb.1:
+    liveins: $lr
+    RET undef $lr
+  bb.2:
+    liveins: $lr
+    RET undef $lr
+...
+---
+name:            f4
+tracksRegLiveness: true
+body:             |
+  bb.0:
+    successors: %bb.1, %bb.2
+    liveins: $x0, $lr
+    DBG_PHI $x0, 1
+    CBZX $x0, %bb.2
+    B %bb.1
+  bb.1:
+    liveins: $lr
+    RET undef $lr
+  bb.2:
+    liveins: $lr
+    RET undef $lr
+...
+)MIR";
+  MachineModuleInfo MMI(TM.get());
+  M = parseMIR(*TM, MIRString, MMI);
+  ASSERT_TRUE(M);
+  auto *MF1 = MMI.getMachineFunction(*M->getFunction("f1"));
+  auto *MF2 = MMI.getMachineFunction(*M->getFunction("f2"));
+  auto *MF3 = MMI.getMachineFunction(*M->getFunction("f3"));
+  auto *MF4 = MMI.getMachineFunction(*M->getFunction("f4"));
+
+  stable_hash Hash1 = stableHashValue(*MF1);
+  EXPECT_NE(Hash1, 0u) << "Expect branches to be hashable.";
+  MachineBlockPositions Positions = getMachineBlockPositions(*MF1);
+  EXPECT_NE(stableHashValue(MF1->front(), Positions), 0u);
+  EXPECT_EQ(Hash1, stableHashValue(*MF2));
+  // Swapping the branch targets changes the CFG.
+  EXPECT_NE(Hash1, stableHashValue(*MF3));
+  // Debug instructions are ignored.
+  EXPECT_EQ(Hash1, stableHashValue(*MF4));
+}
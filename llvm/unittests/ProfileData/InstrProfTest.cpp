@@ -180,6 +180,31 @@ TEST_P(MaybeSparseInstrProfTest, get_function_counts) {
   ASSERT_TRUE(ErrorEquals(instrprof_error::unknown_function, std::move(E2)));
 }
 
+TEST_P(MaybeSparseInstrProfTest, get_function_counts_and_bitmap) {
+  Writer.addRecord({"foo", 0x1234, {1, 2}, {0x05}}, Err);
+  auto Profile = Writer.writeBuffer();
+  readProfile(std::move(Profile));
+
+  std::vector<uint64_t> Counts;
+  BitVector Bitmap;
+  EXPECT_THAT_ERROR(
+      Reader->getFunctionCountsAndBitmap("foo", 0x1234, Counts, Bitmap),
+      Succeeded());
+  ASSERT_EQ(2U, Counts.size());
+  ASSERT_EQ(1U, Counts[0]);
+  ASSERT_EQ(2U, Counts[1]);
+  ASSERT_EQ(8U, Bitmap.size());
+  ASSERT_EQ(2U, Bitmap.count());
+  ASSERT_TRUE(Bitmap.test(0));
+  ASSERT_TRUE(Bitmap.test(2));
+
+  Error E1 = Reader->getFunctionCountsAndBitmap("foo", 0x5678, Counts, Bitmap);
+  ASSERT_TRUE(ErrorEquals(instrprof_error::hash_mismatch, std::move(E1)));
+
+  Error E2 = Reader->getFunctionCountsAndBitmap("bar", 0x1234, Counts, Bitmap);
+  ASSERT_TRUE(ErrorEquals(instrprof_error::unknown_function, std::move(E2)));
+}
+
 // Profile data is copied from general.proftext
 TEST_F(InstrProfTest, get_profile_summary) {
   Writer.addRecord({"func1", 0x1234, {97531}}, Err);
@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Support/Caching.h"
+#include "llvm/Support/Errc.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
@@ -155,3 +156,138 @@ TEST(Caching, NoCommit) {
 
   ASSERT_NO_ERROR(sys::fs::remove_directories(CacheDir.str()));
 }
+
+TEST(Caching, Tiered) {
+  SmallString<256> CacheDir, StoreDir;
+  sys::fs::createUniquePath("llvm_test_cache-%%%%%%", CacheDir, true);
+  sys::fs::createUniquePath("llvm_test_store-%%%%%%", StoreDir, true);
+
+  std::unique_ptr<MemoryBuffer> CachedBuffer;
+  auto AddBuffer = [&CachedBuffer](unsigned Task, const Twine &ModuleName,
+                                   std::unique_ptr<MemoryBuffer> M) {
+    CachedBuffer = std::move(M);
+  };
+  std::shared_ptr<CacheStore> Store = createDirectoryCacheStore(StoreDir);
+
+  // A miss in both levels produces the entry and uploads it to the store.
+  {
+    auto CacheOrErr =
+        localCache("LLVMTestCache", "LLVMTest", CacheDir, AddBuffer);
+    ASSERT_TRUE(bool(CacheOrErr));
+    FileCache Cache = tieredCache(*CacheOrErr, Store);
+
+    auto AddStreamOrErr = Cache(1, "foo", "");
+    ASSERT_TRUE(bool(AddStreamOrErr));
+    AddStreamFn &AddStream = *AddStreamOrErr;
+    ASSERT_TRUE(AddStream);
+
+    auto FileOrErr = AddStream(1, "");
+    ASSERT_TRUE(bool(FileOrErr));
+    CachedFileStream *CFS = FileOrErr->get();
+    (*CFS->OS).write(data, sizeof(data));
+    ASSERT_THAT_ERROR(CFS->commit(), Succeeded());
+    ASSERT_TRUE(CachedBuffer);
+  }
+
+  // With an empty local cache, the entry is served from the store.
+  ASSERT_NO_ERROR(sys::fs::remove_directories(CacheDir.str()));
+  CachedBuffer.reset();
+  {
+    auto CacheOrErr =
+        localCache("LLVMTestCache", "LLVMTest", CacheDir, AddBuffer);
+    ASSERT_TRUE(bool(CacheOrErr));
+    FileCache Cache = tieredCache(*CacheOrErr, Store);
+
+    auto AddStreamOrErr = Cache(1, "foo", "");
+    ASSERT_TRUE(bool(AddStreamOrErr));
+    ASSERT_FALSE(*AddStreamOrErr);
+
+    ASSERT_TRUE(CachedBuffer);
+    ASSERT_EQ(CachedBuffer->getBuffer(), StringRef(data, sizeof(data)));
+  }
+
+  // An unknown key misses in both levels.
+  {
+    auto MBOrErr = Store->get("bar");
+    ASSERT_THAT_EXPECTED(MBOrErr, Succeeded());
+    ASSERT_FALSE(*MBOrErr);
+  }
+
+  ASSERT_NO_ERROR(sys::fs::remove_directories(CacheDir.str()));
+  ASSERT_NO_ERROR(sys::fs::remove_directories(StoreDir.str()));
+}
+
+namespace {
+class FailingStore : public CacheStore {
+public:
+  bool FailGet;
+  unsigned Gets = 0, Puts = 0;
+
+  FailingStore(bool FailGet) : FailGet(FailGet) {}
+
+  Expected<std::unique_ptr<MemoryBuffer>> get(StringRef Key) override {
+    ++Gets;
+    if (FailGet)
+      return createStringError(errc::io_error, "store is down");
+    return nullptr;
+  }
+
+  Error put(StringRef Key, StringRef Data) override {
+    ++Puts;
+    return createStringError(errc::io_error, "store is down");
+  }
+};
+} // namespace
+
+TEST(Caching, TieredFailingStore) {
+  SmallString<256> CacheDir;
+  sys::fs::createUniquePath("llvm_test_cache-%%%%%%", CacheDir, true);
+
+  std::unique_ptr<MemoryBuffer> CachedBuffer;
+  auto AddBuffer = [&CachedBuffer](unsigned Task, const Twine &ModuleName,
+                                   std::unique_ptr<MemoryBuffer> M) {
+    CachedBuffer = std::move(M);
+  };
+  std::vector<std::string> Warnings;
+  auto Warn = [&Warnings](Error E) {
+    Warnings.push_back(toString(std::move(E)));
+  };
+
+  for (bool FailGet : {true, false}) {
+    SCOPED_TRACE(FailGet ? "failing get" : "failing put");
+    ASSERT_NO_ERROR(sys::fs::remove_directories(CacheDir.str()));
+    CachedBuffer.reset();
+    Warnings.clear();
+    auto Store = std::make_shared<FailingStore>(FailGet);
+    auto CacheOrErr =
+        localCache("LLVMTestCache", "LLVMTest", CacheDir, AddBuffer);
+    ASSERT_TRUE(bool(CacheOrErr));
+    FileCache Cache = tieredCache(*CacheOrErr, Store, Warn);
+
+    // The remote error is reported as a warning and the entry is produced
+    // and committed through the local cache.
+    auto AddStreamOrErr = Cache(1, "foo", "");
+    ASSERT_THAT_EXPECTED(AddStreamOrErr, Succeeded());
+    AddStreamFn &AddStream = *AddStreamOrErr;
+    ASSERT_TRUE(AddStream);
+    auto FileOrErr = AddStream(1, "");
+    ASSERT_THAT_EXPECTED(FileOrErr, Succeeded());
+    CachedFileStream *CFS = FileOrErr->get();
+    (*CFS->OS).write(data, sizeof(data));
+    ASSERT_THAT_ERROR(CFS->commit(), Succeeded());
+    ASSERT_TRUE(CachedBuffer);
+    EXPECT_EQ(CachedBuffer->getBuffer(), StringRef(data, sizeof(data)));
+    ASSERT_EQ(Warnings.size(), 1u);
+    EXPECT_NE(Warnings[0].find("store is down"), std::string::npos);
+
+    // After the failure the store is no longer used.
+    auto AddStreamOrErr2 = Cache(1, "bar", "");
+    ASSERT_THAT_EXPECTED(AddStreamOrErr2, Succeeded());
+    ASSERT_TRUE(*AddStreamOrErr2);
+    EXPECT_EQ(Store->Gets, 1u);
+    EXPECT_EQ(Store->Puts, FailGet ? 0u : 1u);
+    EXPECT_EQ(Warnings.size(), 1u);
+  }
+
+  ASSERT_NO_ERROR(sys::fs::remove_directories(CacheDir.str()));
+}
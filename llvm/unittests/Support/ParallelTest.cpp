@@ -16,6 +16,7 @@
 #include "llvm/Support/ThreadPool.h"
 #include "gtest/gtest.h"
 #include <array>
+#include <atomic>
 #include <random>
 
 uint32_t array[1024 * 1024];
@@ -98,7 +99,7 @@ TEST(Parallel, ForEachError) {
 TEST(Parallel, NestedTaskGroup) {
   // This test checks:
   // 1. Root TaskGroup is in Parallel mode.
-  // 2. Nested TaskGroup is not in Parallel mode.
+  // 2. Nested TaskGroup is in Parallel mode as well.
   parallel::TaskGroup tg;
 
   tg.spawn([&]() {
@@ -107,19 +108,59 @@ TEST(Parallel, NestedTaskGroup) {
 
   tg.spawn([&]() {
     parallel::TaskGroup nestedTG;
-    EXPECT_FALSE(nestedTG.isParallel());
+    EXPECT_TRUE(nestedTG.isParallel() ||
+                (parallel::strategy.ThreadsRequested == 1));
 
     nestedTG.spawn([&]() {
       // Check that root TaskGroup is in Parallel mode.
       EXPECT_TRUE(tg.isParallel() ||
                   (parallel::strategy.ThreadsRequested == 1));
 
-      // Check that nested TaskGroup is not in Parallel mode.
-      EXPECT_FALSE(nestedTG.isParallel());
+      // Check that nested TaskGroup is in Parallel mode.
+      EXPECT_TRUE(nestedTG.isParallel() ||
+                  (parallel::strategy.ThreadsRequested == 1));
     });
   });
 }
 
+TEST(Parallel, NestedParallelFor) {
+  // Nested loops are run in parallel on the worker threads. Waiting for the
+  // inner loops must not deadlock, even when there are more outer iterations
+  // than worker threads.
+  constexpr size_t Outer = 64, Inner = 2048;
+  std::vector<std::atomic<uint32_t>> Sums(Outer);
+  parallelFor(0, Outer, [&](size_t I) {
+    parallelFor(0, Inner, [&](size_t J) { Sums[I] += J; });
+  });
+  for (std::atomic<uint32_t> &Sum : Sums)
+    EXPECT_EQ(Sum.load(), Inner * (Inner - 1) / 2);
+
+  std::vector<parallel::WorkerStats> Stats = parallel::getWorkerStats();
+  EXPECT_EQ(Stats.size(), parallel::getThreadCount());
+  uint64_t TasksRun = 0;
+  for (const parallel::WorkerStats &S : Stats)
+    TasksRun += S.TasksRun;
+  EXPECT_TRUE(TasksRun >= Outer || parallel::strategy.ThreadsRequested == 1);
+}
+
+TEST(Parallel, SyncRunsOnlyTasksOfItsGroup) {
+  // A worker that waits for a nested TaskGroup must not pick up unrelated
+  // tasks, which could for example take a lock that the waiter holds.
+  static thread_local bool InNestedSync = false;
+  std::atomic<bool> RanUnrelated = false;
+  parallelFor(0, 64, [&](size_t) {
+    if (InNestedSync)
+      RanUnrelated = true;
+    parallel::TaskGroup TG;
+    for (int I = 0; I < 16; ++I)
+      TG.spawn([] {});
+    InNestedSync = true;
+    TG.sync();
+    InNestedSync = false;
+  });
+  EXPECT_FALSE(RanUnrelated);
+}
+
 TEST(Parallel, ParallelNestedTaskGroup) {
   // This test checks that it is possible to have several TaskGroups
   // run from different threads in Parallel mode.
@@ -134,9 +175,10 @@ TEST(Parallel, ParallelNestedTaskGroup) {
         EXPECT_TRUE(tg.isParallel() ||
                     (parallel::strategy.ThreadsRequested == 1));
 
-        // Check that nested TaskGroup is not in Parallel mode.
+        // Check that nested TaskGroup is in Parallel mode.
         parallel::TaskGroup nestedTG;
-        EXPECT_FALSE(nestedTG.isParallel());
+        EXPECT_TRUE(nestedTG.isParallel() ||
+                    (parallel::strategy.ThreadsRequested == 1));
         ++Count;
 
         nestedTG.spawn([&]() {
@@ -144,8 +186,9 @@ TEST(Parallel, ParallelNestedTaskGroup) {
           EXPECT_TRUE(tg.isParallel() ||
                       (parallel::strategy.ThreadsRequested == 1));
 
-          // Check that nested TaskGroup is not in Parallel mode.
-          EXPECT_FALSE(nestedTG.isParallel());
+          // Check that nested TaskGroup is in Parallel mode.
+          EXPECT_TRUE(nestedTG.isParallel() ||
+                      (parallel::strategy.ThreadsRequested == 1));
           ++Count;
         });
       });
@@ -2125,6 +2125,43 @@ TEST_F(VFSFromYAMLTest, CaseSensitive) {
   EXPECT_EQ(0, NumDiagnostics);
 }
 
+TEST_F(VFSFromYAMLTest, LargeDirectory) {
+  // Directories with many entries are looked up through a name index; check
+  // that it agrees with the linear search in both case modes.
+  IntrusiveRefCntPtr<DummyFileSystem> Lower(new DummyFileSystem());
+  Lower->addRegularFile("//root/foo/bar/a");
+  std::string Contents;
+  for (unsigned I = 0; I != 100; ++I) {
+    if (I)
+      Contents += ",\n";
+    Contents += "{ 'type': 'file', 'name': 'File" + std::to_string(I) +
+                "', 'external-contents': '//root/foo/bar/a' }";
+  }
+  for (StringRef CaseSensitive : {"true", "false"}) {
+    IntrusiveRefCntPtr<vfs::FileSystem> FS = getFromYAMLString(
+        ("{ 'case-sensitive': '" + CaseSensitive +
+         "',\n"
+         "  'roots': [ { 'type': 'directory', 'name': '//root/dir',\n"
+         "               'contents': [ " +
+         Contents + " ] } ] }")
+            .str(),
+        Lower);
+    ASSERT_NE(FS.get(), nullptr);
+
+    EXPECT_FALSE(FS->status("//root/dir/File0").getError());
+    EXPECT_FALSE(FS->status("//root/dir/File57").getError());
+    EXPECT_FALSE(FS->status("//root/dir/File99").getError());
+    EXPECT_EQ(FS->status("//root/dir/File100").getError(),
+              llvm::errc::no_such_file_or_directory);
+    if (CaseSensitive == "true")
+      EXPECT_EQ(FS->status("//root/dir/file57").getError(),
+                llvm::errc::no_such_file_or_directory);
+    else
+      EXPECT_FALSE(FS->status("//root/dir/file57").getError());
+  }
+  EXPECT_EQ(0, NumDiagnostics);
+}
+
 TEST_F(VFSFromYAMLTest, IllegalVFSFile) {
   IntrusiveRefCntPtr<DummyFileSystem> Lower(new DummyFileSystem());
 
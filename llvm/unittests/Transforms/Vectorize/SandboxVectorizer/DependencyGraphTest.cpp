@@ -551,6 +551,36 @@ define void @foo(ptr noalias %ptr0, ptr noalias %ptr1, i8 %v0, i8 %v1) {
   EXPECT_TRUE(RetN->preds(DAG).empty());
 }
 
+TEST_F(DependencyGraphTest, AABudget) {
+  // Build a block with more non-aliasing stores than the default AA budget
+  // (-sbvec-dag-aa-budget=256) allows us to query for a single instruction.
+  constexpr unsigned NumStores = 300;
+  std::string IR = "define void @foo(ptr %ptr, i8 %v) {\n";
+  for (unsigned I = 0; I != NumStores; ++I) {
+    std::string Idx = std::to_string(I);
+    IR += "  %gep" + Idx + " = getelementptr i8, ptr %ptr, i64 " + Idx + "\n";
+    IR += "  store i8 %v, ptr %gep" + Idx + "\n";
+  }
+  IR += "  ret void\n}\n";
+  parseIR(C, IR.c_str());
+  llvm::Function *LLVMF = &*M->getFunction("foo");
+  sandboxir::Context Ctx(C);
+  auto *F = Ctx.createFunction(LLVMF);
+  auto *BB = &*F->begin();
+  sandboxir::DependencyGraph DAG(getAA(*LLVMF), Ctx);
+  DAG.extend({&*BB->begin(), BB->getTerminator()});
+  SmallVector<sandboxir::MemDGNode *> StoreNs;
+  for (sandboxir::Instruction &I : *BB)
+    if (auto *SI = dyn_cast<sandboxir::StoreInst>(&I))
+      StoreNs.push_back(cast<sandboxir::MemDGNode>(DAG.getNode(SI)));
+  ASSERT_EQ(StoreNs.size(), NumStores);
+  // Within budget AA proves that the stores don't alias.
+  EXPECT_TRUE(StoreNs[1]->memPreds().empty());
+  EXPECT_FALSE(memDependency(StoreNs[NumStores - 2], StoreNs[NumStores - 1]));
+  // Stores beyond the budget are conservatively treated as dependencies.
+  EXPECT_TRUE(memDependency(StoreNs[0], StoreNs[NumStores - 1]));
+}
+
 TEST_F(DependencyGraphTest, VolatileLoads) {
   parseIR(C, R"IR(
 define void @foo(ptr noalias %ptr0, ptr noalias %ptr1) {
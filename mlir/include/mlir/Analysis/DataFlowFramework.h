@@ -343,11 +343,8 @@ public:
   const StateT *lookupState(AnchorT anchor) const {
     LatticeAnchor latticeAnchor =
         getLeaderAnchorOrSelf<StateT>(LatticeAnchor(anchor));
-    const auto &mapIt = analysisStates.find(latticeAnchor);
-    if (mapIt == analysisStates.end())
-      return nullptr;
-    auto it = mapIt->second.find(TypeID::get<StateT>());
-    if (it == mapIt->second.end())
+    auto it = analysisStates.find({latticeAnchor, TypeID::get<StateT>()});
+    if (it == analysisStates.end())
       return nullptr;
     return static_cast<const StateT *>(it->second.get());
   }
@@ -367,20 +364,23 @@ public:
 
       // Update analysis states with new leader if needed.
       if (*leaderIt == latticeAnchor && ++leaderIt != eqClass.member_end()) {
-        analysisStates[*leaderIt][TypeId] =
-            std::move(analysisStates[latticeAnchor][TypeId]);
+        std::unique_ptr<AnalysisState> state =
+            std::move(analysisStates[{latticeAnchor, TypeId}]);
+        analysisStates[{*leaderIt, TypeId}] = std::move(state);
       }
 
       eqClass.erase(latticeAnchor);
     }
 
     // Update analysis states.
-    analysisStates.erase(latticeAnchor);
+    for (TypeID stateTypeID : stateTypeIDs)
+      analysisStates.erase({latticeAnchor, stateTypeID});
   }
 
   /// Erase all analysis states.
   void eraseAllStates() {
     analysisStates.clear();
+    stateTypeIDs.clear();
     equivalentAnchorMap.clear();
   }
 
@@ -474,11 +474,16 @@ private:
   /// anchors
   StorageUniquer uniquer;
 
-  /// A type-erased map of lattice anchors to associated analysis states for
-  /// first-class lattice anchors.
-  DenseMap<LatticeAnchor, DenseMap<TypeID, std::unique_ptr<AnalysisState>>>
+  /// A type-erased map of lattice anchors and state types to associated
+  /// analysis states for first-class lattice anchors. The map is keyed on both
+  /// so that an anchor with a handful of states does not need a map of its own.
+  DenseMap<std::pair<LatticeAnchor, TypeID>, std::unique_ptr<AnalysisState>>
       analysisStates;
 
+  /// The types of all analysis states that have been created, used to erase
+  /// every state of a given lattice anchor.
+  SmallVector<TypeID, 4> stateTypeIDs;
+
   /// A map of Ananlysis state type to the equivalent lattice anchors.
   /// Lattice anchors are considered equivalent under a certain analysis state
   /// type if and only if, the analysis states pointed to by these lattice
@@ -733,9 +738,12 @@ StateT *DataFlowSolver::getOrCreateState(AnchorT anchor) {
   // Replace to leader anchor if found.
   LatticeAnchor latticeAnchor(anchor);
   latticeAnchor = getLeaderAnchorOrSelf<StateT>(latticeAnchor);
+  TypeID stateTypeID = TypeID::get<StateT>();
   std::unique_ptr<AnalysisState> &state =
-      analysisStates[latticeAnchor][TypeID::get<StateT>()];
+      analysisStates[{latticeAnchor, stateTypeID}];
   if (!state) {
+    if (!llvm::is_contained(stateTypeIDs, stateTypeID))
+      stateTypeIDs.push_back(stateTypeID);
     state = std::unique_ptr<StateT>(new StateT(anchor));
 #if LLVM_ENABLE_ABI_BREAKING_CHECKS
     state->debugName = llvm::getTypeName<StateT>();
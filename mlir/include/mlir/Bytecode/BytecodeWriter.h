@@ -189,6 +189,12 @@ private:
 /// Write the bytecode for the given operation to the provided output stream.
 /// For streams where it matters, the given stream should be in "binary" mode.
 /// It only ever fails if setDesiredByteCodeVersion can't be honored.
+///
+/// Resource and dialect blobs are not copied while encoding: the writer keeps
+/// references to their existing storage and writes them straight to `os` at
+/// the end. Writing large blobs therefore only needs extra memory if `os`
+/// itself buffers everything, e.g. a raw_string_ostream; prefer writing
+/// directly to a file stream.
 LogicalResult writeBytecodeToFile(Operation *op, raw_ostream &os,
                                   const BytecodeWriterConfig &config = {});
 
@@ -92,6 +92,14 @@ struct ExecutionEngineOptions {
   /// be dumped to a file via the `dumpToObjectFile` method.
   bool enableObjectDump = false;
 
+  /// If `objectCache` is provided, the JIT compiler consults it before
+  /// compiling the module and notifies it of the generated object. The module
+  /// identifier is set to a hash of the final LLVM IR and the target
+  /// configuration, so a persistent cache can reuse objects across processes.
+  /// This replaces the cache created for `enableObjectDump`, which has no
+  /// effect when a cache is provided.
+  llvm::ObjectCache *objectCache = nullptr;
+
   /// If enable `enableGDBNotificationListener` is set, the JIT compiler will
   /// notify the llvm's global GDB notification listener.
   bool enableGDBNotificationListener = true;
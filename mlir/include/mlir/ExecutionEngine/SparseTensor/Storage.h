@@ -660,6 +660,28 @@ SparseTensorStorage<P, C, V>::SparseTensorStorage(
     const uint64_t nse = elements.size();
     assert(values.size() == 0);
     values.reserve(nse);
+    // Refine the coordinate capacity hints now that the number of stored
+    // elements is known: a sparse level holds at most one coordinate per
+    // element, and at most as many as its dense upper bound.
+    uint64_t parentSz = 1;
+    for (uint64_t l = 0; l < lvlRank; l++) {
+      if (isDenseLvl(l)) {
+        parentSz = detail::checkedMul(parentSz, lvlSizes[l]);
+        continue;
+      }
+      if (isNOutOfMLvl(l))
+        continue;
+      if (isCompressedLvl(l) || isLooseCompressedLvl(l)) {
+        // An empty level holds no coordinates.
+        if (lvlSizes[l] == 0)
+          parentSz = 0;
+        else if (parentSz > nse / lvlSizes[l])
+          parentSz = nse;
+        else
+          parentSz = std::min(nse, parentSz * lvlSizes[l]);
+      }
+      coordinates[l].reserve(std::min(parentSz, nse));
+    }
     fromCOO(elements, 0, nse, 0);
   } else if (allDense) {
     /* New empty (all dense) */
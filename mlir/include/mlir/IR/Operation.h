@@ -81,6 +81,13 @@ enum class OpProperties : char {};
 ///
 /// Finally an Operation also contain an optional `DictionaryAttr`, a Location,
 /// and a pointer to its parent Block (if any).
+///
+/// The results, operands, properties, regions and block operands described
+/// above are all co-allocated with the Operation in a single allocation. The
+/// only additional per-operation allocations are an out-of-line operand array
+/// when operands are added beyond the initial capacity, and whatever the
+/// properties object allocates itself. The attribute dictionary and the
+/// Location are uniqued in the context and shared between operations.
 class alignas(8) Operation final
     : public llvm::ilist_node_with_parent<Operation, Block>,
       private llvm::TrailingObjects<Operation, detail::OperandStorage,
@@ -307,14 +307,20 @@ static void setTokenState(AsyncToken *token, State state) {
   assert(State(token->state).isUnavailable() && "token must be unavailable");
 
   // Make sure that `dropRef` does not destroy the mutex owned by the lock.
+  std::vector<std::function<void()>> awaiters;
   {
     std::unique_lock<std::mutex> lock(token->mu);
     token->state = state;
     token->cv.notify_all();
-    for (auto &awaiter : token->awaiters)
-      awaiter();
+    awaiters.swap(token->awaiters);
   }
 
+  // Once the state is terminal no new awaiters can be added, so run the
+  // pending ones without holding the lock. They typically resume coroutines
+  // that may do arbitrary amounts of work.
+  for (auto &awaiter : awaiters)
+    awaiter();
+
   // Async tokens created with a ref count `2` to keep token alive until the
   // async task completes. Drop this reference explicitly when token emplaced.
   token->dropRef();
@@ -325,14 +331,20 @@ static void setValueState(AsyncValue *value, State state) {
   assert(State(value->state).isUnavailable() && "value must be unavailable");
 
   // Make sure that `dropRef` does not destroy the mutex owned by the lock.
+  std::vector<std::function<void()>> awaiters;
   {
     std::unique_lock<std::mutex> lock(value->mu);
     value->state = state;
     value->cv.notify_all();
-    for (auto &awaiter : value->awaiters)
-      awaiter();
+    awaiters.swap(value->awaiters);
   }
 
+  // Once the state is terminal no new awaiters can be added, so run the
+  // pending ones without holding the lock. They typically resume coroutines
+  // that may do arbitrary amounts of work.
+  for (auto &awaiter : awaiters)
+    awaiter();
+
   // Async values created with a ref count `2` to keep value alive until the
   // async task completes. Drop this reference explicitly when value emplaced.
   value->dropRef();
@@ -367,6 +379,9 @@ extern "C" bool mlirAsyncRuntimeIsGroupError(AsyncGroup *group) {
 }
 
 extern "C" void mlirAsyncRuntimeAwaitToken(AsyncToken *token) {
+  // Avoid taking the lock if the token is already in a terminal state.
+  if (State(token->state).isAvailableOrError())
+    return;
   std::unique_lock<std::mutex> lock(token->mu);
   if (!State(token->state).isAvailableOrError())
     token->cv.wait(
@@ -374,6 +389,9 @@ extern "C" void mlirAsyncRuntimeAwaitToken(AsyncToken *token) {
 }
 
 extern "C" void mlirAsyncRuntimeAwaitValue(AsyncValue *value) {
+  // Avoid taking the lock if the value is already in a terminal state.
+  if (State(value->state).isAvailableOrError())
+    return;
   std::unique_lock<std::mutex> lock(value->mu);
   if (!State(value->state).isAvailableOrError())
     value->cv.wait(
@@ -381,6 +399,9 @@ extern "C" void mlirAsyncRuntimeAwaitValue(AsyncValue *value) {
 }
 
 extern "C" void mlirAsyncRuntimeAwaitAllInGroup(AsyncGroup *group) {
+  // Avoid taking the lock if all tokens in the group are already ready.
+  if (group->pendingTokens == 0)
+    return;
   std::unique_lock<std::mutex> lock(group->mu);
   if (group->pendingTokens != 0)
     group->cv.wait(lock, [group] { return group->pendingTokens == 0; });
@@ -401,6 +422,10 @@ extern "C" void mlirAsyncRuntimeAwaitTokenAndExecute(AsyncToken *token,
                                                      CoroHandle handle,
                                                      CoroResume resume) {
   auto execute = [handle, resume]() { (*resume)(handle); };
+  if (State(token->state).isAvailableOrError()) {
+    execute();
+    return;
+  }
   std::unique_lock<std::mutex> lock(token->mu);
   if (State(token->state).isAvailableOrError()) {
     lock.unlock();
@@ -414,6 +439,10 @@ extern "C" void mlirAsyncRuntimeAwaitValueAndExecute(AsyncValue *value,
                                                      CoroHandle handle,
                                                      CoroResume resume) {
   auto execute = [handle, resume]() { (*resume)(handle); };
+  if (State(value->state).isAvailableOrError()) {
+    execute();
+    return;
+  }
   std::unique_lock<std::mutex> lock(value->mu);
   if (State(value->state).isAvailableOrError()) {
     lock.unlock();
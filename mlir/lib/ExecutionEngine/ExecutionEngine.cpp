@@ -16,6 +16,8 @@
 #include "mlir/Support/FileUtilities.h"
 #include "mlir/Target/LLVMIR/Export.h"
 
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
 #include "llvm/ExecutionEngine/JITEventListener.h"
 #include "llvm/ExecutionEngine/ObjectCache.h"
 #include "llvm/ExecutionEngine/Orc/CompileUtils.h"
@@ -28,7 +30,9 @@
 #include "llvm/MC/TargetRegistry.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/Error.h"
+#include "llvm/Support/SHA256.h"
 #include "llvm/Support/ToolOutputFile.h"
+#include "llvm/Target/TargetMachine.h"
 #include "llvm/TargetParser/Host.h"
 #include "llvm/TargetParser/SubtargetFeature.h"
 
@@ -62,6 +66,104 @@ static Error makeStringError(const Twine &message) {
                                        llvm::inconvertibleErrorCode());
 }
 
+/// Write `str` to `os` so that the end of one string can not be mistaken for
+/// the start of the next one.
+static void writeKeyString(llvm::raw_ostream &os, StringRef str) {
+  os << str.size() << ':' << str << ';';
+}
+
+/// Return a description of the configuration of `tm` that affects the
+/// generated code, for use in object cache keys. Every field of TargetOptions
+/// and MCTargetOptions is included, new options must be added here too.
+static std::string getTargetKey(const llvm::TargetMachine &tm) {
+  std::string key;
+  llvm::raw_string_ostream os(key);
+  writeKeyString(os, tm.getTargetTriple().str());
+  writeKeyString(os, tm.getTargetCPU());
+  writeKeyString(os, tm.getTargetFeatureString());
+  os << static_cast<int>(tm.getOptLevel()) << ';'
+     << static_cast<int>(tm.getRelocationModel()) << ';'
+     << static_cast<int>(tm.getCodeModel()) << ';';
+
+  const llvm::TargetOptions &o = tm.Options;
+  os << o.BinutilsVersion.first << '.' << o.BinutilsVersion.second << ';';
+  os << o.UnsafeFPMath << o.NoInfsFPMath << o.NoNaNsFPMath
+     << o.NoTrappingFPMath << o.NoSignedZerosFPMath << o.ApproxFuncFPMath
+     << o.EnableAIXExtendedAltivecABI
+     << o.HonorSignDependentRoundingFPMathOption << o.NoZerosInBSS
+     << o.GuaranteedTailCallOpt << o.StackSymbolOrdering << o.EnableFastISel
+     << o.EnableGlobalISel << o.UseInitArray << o.DisableIntegratedAS
+     << o.FunctionSections << o.DataSections << o.IgnoreXCOFFVisibility
+     << o.XCOFFTracebackTable << o.UniqueSectionNames
+     << o.UniqueBasicBlockSectionNames << o.SeparateNamedSections
+     << o.TrapUnreachable << o.NoTrapAfterNoreturn << o.EmulatedTLS
+     << o.EnableTLSDESC << o.EnableIPRA << o.EmitStackSizeSection
+     << o.EnableMachineOutliner << o.EnableMachineFunctionSplitter
+     << o.EnableStaticDataPartitioning << o.SupportsDefaultOutlining
+     << o.EmitAddrsig << o.BBAddrMap << o.EmitCallSiteInfo
+     << o.SupportsDebugEntryValues << o.EnableDebugEntryValues
+     << o.ValueTrackingVariableLocations << o.ForceDwarfFrameSection
+     << o.XRayFunctionIndex << o.DebugStrictDwarf << o.Hotpatch
+     << o.PPCGenScalarMASSEntries << o.JMCInstrument << o.EnableCFIFixup
+     << o.MisExpect << o.XCOFFReadOnlyPointers << o.VerifyArgABICompliance
+     << ';' << static_cast<int>(o.GlobalISelAbort) << ';'
+     << static_cast<int>(o.SwiftAsyncFramePointer) << ';' << o.TLSSize << ';'
+     << static_cast<int>(o.BBSections) << ';';
+  writeKeyString(os, o.BBSectionsFuncListBuf
+                         ? o.BBSectionsFuncListBuf->getBuffer()
+                         : StringRef());
+  writeKeyString(os, o.StackUsageOutput);
+  os << o.LoopAlignment << ';' << static_cast<int>(o.FloatABIType) << ';'
+     << static_cast<int>(o.AllowFPOpFusion) << ';'
+     << static_cast<int>(o.ThreadModel) << ';'
+     << static_cast<int>(o.EABIVersion) << ';'
+     << static_cast<int>(o.DebuggerTuning) << ';';
+  for (llvm::DenormalMode mode :
+       {o.getRawFPDenormalMode(), o.getRawFP32DenormalMode()})
+    os << static_cast<int>(mode.Output) << static_cast<int>(mode.Input) << ';';
+  os << static_cast<int>(o.ExceptionModel) << ';';
+  writeKeyString(os, o.ObjectFilenameForDebug);
+
+  const llvm::MCTargetOptions &mc = o.MCOptions;
+  os << mc.MCRelaxAll << mc.MCNoExecStack << mc.MCFatalWarnings << mc.MCNoWarn
+     << mc.MCNoDeprecatedWarn << mc.MCNoTypeCheck << mc.MCSaveTempLabels
+     << mc.MCIncrementalLinkerCompatible << mc.FDPIC << mc.ShowMCEncoding
+     << mc.ShowMCInst << mc.AsmVerbose << mc.PreserveAsmComments << mc.Dwarf64
+     << mc.Crel << mc.ImplicitMapSyms << mc.X86RelaxRelocations
+     << mc.X86Sse2Avx << mc.EmitCompactUnwindNonCanonical
+     << mc.PPCUseFullRegisterNames << ';'
+     << (mc.OutputAsmVariant ? static_cast<int>(*mc.OutputAsmVariant) : -1)
+     << ';' << static_cast<int>(mc.EmitDwarfUnwind) << ';' << mc.DwarfVersion
+     << ';' << static_cast<int>(mc.MCUseDwarfDirectory) << ';'
+     << static_cast<int>(mc.CompressDebugSections) << ';';
+  for (StringRef str : {StringRef(mc.ABIName), StringRef(mc.AssemblyLanguage),
+                        StringRef(mc.SplitDwarfFile),
+                        StringRef(mc.AsSecureLogFile), StringRef(mc.Argv0),
+                        StringRef(mc.CommandlineArgs)})
+    writeKeyString(os, str);
+  for (const std::vector<std::string> *strs :
+       {&mc.IASSearchPaths, &mc.InstPrinterOptions}) {
+    os << strs->size() << ';';
+    for (const std::string &str : *strs)
+      writeKeyString(os, str);
+  }
+  return key;
+}
+
+/// Return a key for the object generated from `module` with the target
+/// configuration described by `targetKey`.
+static std::string computeObjectCacheKey(const Module &module,
+                                         StringRef targetKey) {
+  SmallString<0> bitcode;
+  llvm::raw_svector_ostream os(bitcode);
+  llvm::WriteBitcodeToFile(module, os);
+
+  llvm::SHA256 hasher;
+  hasher.update(targetKey);
+  hasher.update(bitcode);
+  return llvm::toHex(hasher.final(), /*LowerCase=*/true);
+}
+
 void SimpleObjectCache::notifyObjectCompiled(const Module *m,
                                              MemoryBufferRef objBuffer) {
   cachedObjects[m->getModuleIdentifier()] = MemoryBuffer::getMemBufferCopy(
@@ -233,7 +335,8 @@ Expected<std::unique_ptr<ExecutionEngine>>
 ExecutionEngine::create(Operation *m, const ExecutionEngineOptions &options,
                         std::unique_ptr<llvm::TargetMachine> tm) {
   auto engine = std::make_unique<ExecutionEngine>(
-      options.enableObjectDump, options.enableGDBNotificationListener,
+      options.enableObjectDump && !options.objectCache,
+      options.enableGDBNotificationListener,
       options.enablePerfNotificationListener);
 
   // Remember all entry-points if object dumping is enabled.
@@ -358,14 +461,23 @@ ExecutionEngine::create(Operation *m, const ExecutionEngineOptions &options,
     return objectLayer;
   };
 
+  // Describe the target configuration for the object cache key. This must be
+  // done before the target machine is handed over to the compiler below, which
+  // generates code with its options and optimization level.
+  std::string targetKey;
+  if (options.objectCache)
+    targetKey = getTargetKey(*tm);
+
   // Callback to inspect the cache and recompile on demand. This follows Lang's
   // LLJITWithObjectCache example.
+  llvm::ObjectCache *objectCache =
+      options.objectCache ? options.objectCache : engine->cache.get();
   auto compileFunctionCreator = [&](JITTargetMachineBuilder jtmb)
       -> Expected<std::unique_ptr<IRCompileLayer::IRCompiler>> {
     if (options.jitCodeGenOptLevel)
       jtmb.setCodeGenOptLevel(*options.jitCodeGenOptLevel);
     return std::make_unique<TMOwningSimpleCompiler>(std::move(tm),
-                                                    engine->cache.get());
+                                                    objectCache);
   };
 
   // Create the LLJIT by calling the LLJITBuilder with 2 callbacks.
@@ -381,6 +493,11 @@ ExecutionEngine::create(Operation *m, const ExecutionEngineOptions &options,
   if (options.transformer)
     cantFail(tsm.withModuleDo(
         [&](llvm::Module &module) { return options.transformer(&module); }));
+  if (options.objectCache) {
+    tsm.withModuleDo([&](llvm::Module &module) {
+      module.setModuleIdentifier(computeObjectCacheKey(module, targetKey));
+    });
+  }
   cantFail(jit->addIRModule(std::move(tsm)));
   engine->jit = std::move(jit);
 
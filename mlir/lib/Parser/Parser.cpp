@@ -13,6 +13,7 @@
 #include "mlir/Parser/Parser.h"
 #include "mlir/AsmParser/AsmParser.h"
 #include "mlir/Bytecode/BytecodeReader.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/SourceMgr.h"
 
 using namespace mlir;
@@ -61,11 +62,27 @@ static LogicalResult loadSourceFileBuffer(llvm::StringRef filename,
     return emitError(mlir::UnknownLoc::get(ctx),
                      "only main buffer parsed at the moment");
   }
-  auto fileOrErr = llvm::MemoryBuffer::getFileOrSTDIN(filename);
+  // Bytecode does not need a trailing null, and requiring one prevents the
+  // file from being mapped when its size is a multiple of the page size. Open
+  // without it so that large bytecode files are always mapped and their
+  // resource blobs can be referenced in place.
+  auto fileOrErr = llvm::MemoryBuffer::getFileOrSTDIN(
+      filename, /*IsText=*/false, /*RequiresNullTerminator=*/false);
   if (fileOrErr.getError())
     return emitError(mlir::UnknownLoc::get(ctx),
                      "could not open input file " + filename);
 
+  // The textual parser does rely on the null terminator. Buffers that were
+  // read into memory always have one, but a mapped file might not, so reopen
+  // it in that case.
+  if (!isBytecode(**fileOrErr) &&
+      (*fileOrErr)->getBufferKind() == llvm::MemoryBuffer::MemoryBuffer_MMap) {
+    fileOrErr = llvm::MemoryBuffer::getFileOrSTDIN(filename);
+    if (fileOrErr.getError())
+      return emitError(mlir::UnknownLoc::get(ctx),
+                       "could not open input file " + filename);
+  }
+
   // Load the MLIR source file.
   sourceMgr.AddNewSourceBuffer(std::move(*fileOrErr), SMLoc());
   return success();
@@ -602,7 +602,8 @@ LogicalResult OpToOpPassAdaptor::run(Pass *pass, Operation *op,
 LogicalResult OpToOpPassAdaptor::runPipeline(
     OpPassManager &pm, Operation *op, AnalysisManager am, bool verifyPasses,
     unsigned parentInitGeneration, PassInstrumentor *instrumentor,
-    const PassInstrumentation::PipelineParentInfo *parentInfo) {
+    const PassInstrumentation::PipelineParentInfo *parentInfo,
+    bool *allPreserved) {
   assert((!instrumentor || parentInfo) &&
          "expected parent info if instrumentor is provided");
   auto scopeExit = llvm::make_scope_exit([&] {
@@ -619,9 +620,12 @@ LogicalResult OpToOpPassAdaptor::runPipeline(
                                     *parentInfo);
   }
 
-  for (Pass &pass : pm.getPasses())
+  for (Pass &pass : pm.getPasses()) {
     if (failed(run(&pass, op, am, verifyPasses, parentInitGeneration)))
       return failure();
+    if (allPreserved && !pass.passState->preservedAnalyses.isAll())
+      *allPreserved = false;
+  }
 
   if (instrumentor) {
     instrumentor->runAfterPipeline(pm.getOpName(*op->getContext()),
@@ -752,6 +756,7 @@ void OpToOpPassAdaptor::runOnOperationImpl(bool verifyPasses) {
   PassInstrumentation::PipelineParentInfo parentInfo = {llvm::get_threadid(),
                                                         this};
   auto *instrumentor = am.getPassInstrumentor();
+  bool allPreserved = true;
   for (auto &region : getOperation()->getRegions()) {
     for (auto &block : region) {
       for (auto &op : block) {
@@ -762,11 +767,18 @@ void OpToOpPassAdaptor::runOnOperationImpl(bool verifyPasses) {
         // Run the held pipeline over the current operation.
         unsigned initGeneration = mgr->impl->initializationGeneration;
         if (failed(runPipeline(*mgr, &op, am.nest(&op), verifyPasses,
-                               initGeneration, instrumentor, &parentInfo)))
+                               initGeneration, instrumentor, &parentInfo,
+                               &allPreserved)))
           signalPassFailure();
       }
     }
   }
+
+  // If none of the nested passes changed the IR, neither did this adaptor.
+  // This avoids invalidating the analyses of the parent operation and
+  // re-verifying it.
+  if (allPreserved)
+    markAllAnalysesPreserved();
 }
 
 /// Utility functor that checks if the two ranges of pass managers have a size
@@ -831,6 +843,7 @@ void OpToOpPassAdaptor::runOnOperationAsyncImpl(bool verifyPasses) {
   std::vector<std::atomic<bool>> activePMs(asyncExecutors.size());
   llvm::fill(activePMs, false);
   std::atomic<bool> hasFailure = false;
+  std::atomic<bool> allPreserved = true;
   parallelForEach(context, opInfos, [&](OpPMInfo &opInfo) {
     // Find an executor for this operation.
     auto it = llvm::find_if(activePMs, [](std::atomic<bool> &isActive) {
@@ -841,11 +854,15 @@ void OpToOpPassAdaptor::runOnOperationAsyncImpl(bool verifyPasses) {
 
     // Get the pass manager for this operation and execute it.
     OpPassManager &pm = asyncExecutors[pmIndex][opInfo.passManagerIdx];
+    bool pipelinePreserved = true;
     LogicalResult pipelineResult = runPipeline(
         pm, opInfo.op, opInfo.am, verifyPasses,
-        pm.impl->initializationGeneration, instrumentor, &parentInfo);
+        pm.impl->initializationGeneration, instrumentor, &parentInfo,
+        &pipelinePreserved);
     if (failed(pipelineResult))
       hasFailure.store(true);
+    if (!pipelinePreserved)
+      allPreserved.store(false);
 
     // Reset the active bit for this pass manager.
     activePMs[pmIndex].store(false);
@@ -854,6 +871,10 @@ void OpToOpPassAdaptor::runOnOperationAsyncImpl(bool verifyPasses) {
   // Signal a failure if any of the executors failed.
   if (hasFailure)
     signalPassFailure();
+
+  // If none of the nested passes changed the IR, neither did this adaptor.
+  if (allPreserved)
+    markAllAnalysesPreserved();
 }
 
 //===----------------------------------------------------------------------===//
@@ -75,11 +75,13 @@ private:
   /// Run the given operation and analysis manager on a provided op pass
   /// manager. `parentInitGeneration` is the initialization generation of the
   /// parent pass manager, and is used to initialize any dynamic pass pipelines
-  /// run by the given passes.
+  /// run by the given passes. If `allPreserved` is provided, it is set to
+  /// false if any of the passes did not preserve all analyses.
   static LogicalResult runPipeline(
       OpPassManager &pm, Operation *op, AnalysisManager am, bool verifyPasses,
       unsigned parentInitGeneration, PassInstrumentor *instrumentor = nullptr,
-      const PassInstrumentation::PipelineParentInfo *parentInfo = nullptr);
+      const PassInstrumentation::PipelineParentInfo *parentInfo = nullptr,
+      bool *allPreserved = nullptr);
 
   /// A set of adaptors to run.
   SmallVector<OpPassManager, 1> mgrs;
@@ -11,7 +11,11 @@
 #include "mlir/Support/LLVM.h"
 #include "mlir/Support/ThreadLocalCache.h"
 #include "mlir/Support/TypeID.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/RWMutex.h"
+#include "llvm/Support/Threading.h"
+
+#include <algorithm>
 
 using namespace mlir;
 using namespace mlir::detail;
@@ -109,11 +113,22 @@ private:
 
 public:
 #if LLVM_ENABLE_THREADS != 0
+  /// Return the default number of shards: enough to keep lock contention low
+  /// when every hardware thread is creating instances, but never less than 8.
+  /// Shards are allocated lazily, so unused ones only cost a pointer.
+  static size_t getDefaultNumShards() {
+    static const size_t numShards = std::clamp<size_t>(
+        llvm::PowerOf2Ceil(
+            llvm::hardware_concurrency().compute_thread_count() * 2),
+        8, 256);
+    return numShards;
+  }
+
   /// Initialize the storage uniquer with a given number of storage shards to
   /// use. The provided shard number is required to be a valid power of 2. The
   /// destructor function is used to destroy any allocated storage instances.
   ParametricStorageUniquer(function_ref<void(BaseStorage *)> destructorFn,
-                           size_t numShards = 8)
+                           size_t numShards = getDefaultNumShards())
       : shards(new std::atomic<Shard *>[numShards]), numShards(numShards),
         destructorFn(destructorFn) {
     assert(llvm::isPowerOf2_64(numShards) &&
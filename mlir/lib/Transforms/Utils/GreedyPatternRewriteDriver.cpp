@@ -233,9 +233,10 @@ void Worklist::clear() {
 }
 
 bool Worklist::empty() const {
-  // Skip all nullptr.
-  return !llvm::any_of(list,
-                       [](Operation *op) { return static_cast<bool>(op); });
+  // `map` only tracks the ops that are still on the worklist, whereas `list`
+  // may contain nullptr holes left behind by `remove`. Checking `map` avoids
+  // rescanning those holes every time the driver checks for more work.
+  return map.empty();
 }
 
 void Worklist::push(Operation *op) {
@@ -273,7 +274,8 @@ void Worklist::remove(Operation *op) {
 void Worklist::reverse() {
   std::reverse(list.begin(), list.end());
   for (size_t i = 0, e = list.size(); i != e; ++i)
-    map[list[i]] = i;
+    if (list[i])
+      map[list[i]] = i;
 }
 
 #ifdef MLIR_GREEDY_REWRITE_RANDOMIZER_SEED
@@ -296,8 +298,10 @@ public:
       op = list[pos];
       list.erase(list.begin() + pos);
       for (int64_t i = pos, e = list.size(); i < e; ++i)
-        map[list[i]] = i;
-      map.erase(op);
+        if (list[i])
+          map[list[i]] = i;
+      if (op)
+        map.erase(op);
     } while (!op);
     return op;
   }
@@ -0,0 +1,127 @@
+//===- ObjectCache.cpp - Tests for the object cache keys ------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Dialect/LLVMIR/LLVMDialect.h"
+#include "mlir/ExecutionEngine/ExecutionEngine.h"
+#include "mlir/IR/MLIRContext.h"
+#include "mlir/Parser/Parser.h"
+#include "mlir/Target/LLVMIR/Dialect/Builtin/BuiltinToLLVMIRTranslation.h"
+#include "mlir/Target/LLVMIR/Dialect/LLVMIR/LLVMToLLVMIRTranslation.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
+#include "llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Target/TargetMachine.h"
+
+#include "gmock/gmock.h"
+
+// SPARC currently lacks JIT support.
+#if defined(__sparc__)
+#define SKIP_WITHOUT_JIT(x) DISABLED_##x
+#else
+#define SKIP_WITHOUT_JIT(x) x
+#endif
+
+using namespace mlir;
+
+// The JIT isn't supported on Windows at that time
+#ifndef _WIN32
+
+static struct LLVMInitializer {
+  LLVMInitializer() {
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+  }
+} initializer;
+
+namespace {
+/// Records the key of every object the JIT compiles, never returns one.
+class RecordingObjectCache : public llvm::ObjectCache {
+public:
+  void notifyObjectCompiled(const llvm::Module *m,
+                            llvm::MemoryBufferRef) override {
+    keys.push_back(m->getModuleIdentifier());
+  }
+
+  std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module *) override {
+    return nullptr;
+  }
+
+  std::vector<std::string> keys;
+};
+} // namespace
+
+/// Compile `module` with a host target machine whose options are adjusted by
+/// `setOptions`, and return the key it was cached under.
+static std::string
+getObjectKey(ModuleOp module,
+             llvm::function_ref<void(llvm::TargetOptions &)> setOptions) {
+  auto tmBuilderOrError = llvm::orc::JITTargetMachineBuilder::detectHost();
+  if (!tmBuilderOrError) {
+    llvm::consumeError(tmBuilderOrError.takeError());
+    return "";
+  }
+  auto tmOrError = tmBuilderOrError->createTargetMachine();
+  if (!tmOrError) {
+    llvm::consumeError(tmOrError.takeError());
+    return "";
+  }
+  std::unique_ptr<llvm::TargetMachine> tm = std::move(*tmOrError);
+  setOptions(tm->Options);
+
+  RecordingObjectCache cache;
+  ExecutionEngineOptions options;
+  options.objectCache = &cache;
+  auto engine = ExecutionEngine::create(module, options, std::move(tm));
+  if (!engine) {
+    llvm::consumeError(engine.takeError());
+    return "";
+  }
+  llvm::Expected<void *> fn = (*engine)->lookup("foo");
+  if (!fn) {
+    llvm::consumeError(fn.takeError());
+    return "";
+  }
+  return cache.keys.empty() ? "" : cache.keys.front();
+}
+
+TEST(ObjectCache, SKIP_WITHOUT_JIT(KeyDependsOnTargetOptions)) {
+  std::string moduleStr = R"mlir(
+  llvm.func @foo() {
+    llvm.return
+  }
+  )mlir";
+  DialectRegistry registry;
+  registerBuiltinDialectTranslation(registry);
+  registerLLVMDialectTranslation(registry);
+  MLIRContext context(registry);
+  OwningOpRef<ModuleOp> module =
+      parseSourceString<ModuleOp>(moduleStr, &context);
+  ASSERT_TRUE(!!module);
+
+  auto defaults = [](llvm::TargetOptions &) {};
+  std::string defaultKey = getObjectKey(*module, defaults);
+  ASSERT_FALSE(defaultKey.empty());
+  EXPECT_EQ(defaultKey, getObjectKey(*module, defaults));
+
+  // Options from TargetOptions and from its MCTargetOptions both change the
+  // key.
+  std::string addrsigKey = getObjectKey(
+      *module, [](llvm::TargetOptions &o) { o.EmitAddrsig = !o.EmitAddrsig; });
+  ASSERT_FALSE(addrsigKey.empty());
+  EXPECT_NE(defaultKey, addrsigKey);
+
+  std::string dwarfKey = getObjectKey(*module, [](llvm::TargetOptions &o) {
+    o.MCOptions.DwarfVersion = 4;
+  });
+  ASSERT_FALSE(dwarfKey.empty());
+  EXPECT_NE(defaultKey, dwarfKey);
+  EXPECT_NE(addrsigKey, dwarfKey);
+}
+
+#endif // _WIN32
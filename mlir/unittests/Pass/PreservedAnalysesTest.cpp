@@ -0,0 +1,90 @@
+//===- PreservedAnalysesTest.cpp - Preserved analyses through adaptors ----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/Pass/Pass.h"
+#include "mlir/Pass/PassManager.h"
+#include "gtest/gtest.h"
+
+using namespace mlir;
+
+namespace {
+/// An analysis that counts how many times it has been computed.
+struct CountingAnalysis {
+  CountingAnalysis(Operation *) { ++numComputations; }
+  static int numComputations;
+};
+int CountingAnalysis::numComputations = 0;
+
+/// A module pass that queries CountingAnalysis and does not change the IR.
+struct QueryAnalysisPass
+    : public PassWrapper<QueryAnalysisPass, OperationPass<ModuleOp>> {
+  MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(QueryAnalysisPass)
+
+  void runOnOperation() override {
+    getAnalysis<CountingAnalysis>();
+    markAllAnalysesPreserved();
+  }
+};
+
+/// A function pass that does not change the IR, and that reports so only if
+/// `preserve` is set.
+struct NoopFuncPass
+    : public PassWrapper<NoopFuncPass, OperationPass<func::FuncOp>> {
+  MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(NoopFuncPass)
+
+  NoopFuncPass(bool preserve) : preserve(preserve) {}
+
+  void runOnOperation() override {
+    if (preserve)
+      markAllAnalysesPreserved();
+  }
+
+  bool preserve;
+};
+
+/// Run a module pipeline that queries CountingAnalysis around a nested
+/// function pipeline, and return how many times the analysis was computed.
+int countComputations(bool preserve, bool threading) {
+  MLIRContext context;
+  context.loadDialect<func::FuncDialect>();
+  context.enableMultithreading(threading);
+
+  OpBuilder builder(&context);
+  Location loc = builder.getUnknownLoc();
+  OwningOpRef<ModuleOp> module(ModuleOp::create(loc));
+  builder.setInsertionPointToEnd(module->getBody());
+  for (StringRef name : {"a", "b", "c"}) {
+    auto func = builder.create<func::FuncOp>(loc, name,
+                                             builder.getFunctionType({}, {}));
+    OpBuilder::InsertionGuard guard(builder);
+    builder.setInsertionPointToEnd(func.addEntryBlock());
+    builder.create<func::ReturnOp>(loc);
+  }
+
+  CountingAnalysis::numComputations = 0;
+  PassManager pm(&context);
+  pm.addPass(std::make_unique<QueryAnalysisPass>());
+  pm.addNestedPass<func::FuncOp>(std::make_unique<NoopFuncPass>(preserve));
+  pm.addPass(std::make_unique<QueryAnalysisPass>());
+  EXPECT_TRUE(succeeded(pm.run(module.get())));
+  return CountingAnalysis::numComputations;
+}
+} // namespace
+
+TEST(PreservedAnalysesTest, AdaptorPreservesWhenNestedPassesDo) {
+  EXPECT_EQ(countComputations(/*preserve=*/true, /*threading=*/false), 1);
+  EXPECT_EQ(countComputations(/*preserve=*/true, /*threading=*/true), 1);
+}
+
+TEST(PreservedAnalysesTest, AdaptorInvalidatesWhenNestedPassesDoNot) {
+  EXPECT_EQ(countComputations(/*preserve=*/false, /*threading=*/false), 2);
+  EXPECT_EQ(countComputations(/*preserve=*/false, /*threading=*/true), 2);
+}